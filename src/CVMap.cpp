@@ -35,6 +35,10 @@ struct CVMapModule : CVMapModuleBase<MAX_CHANNELS> {
 	bool locked;
 	/** [Stored to JSON] */
 	int mapInput[MAX_CHANNELS];
+	/** [Stored to JSON] Number of samples between parameter updates in audio rate mode, 1 updates every sample */
+	int blockSize;
+	/** [Stored to JSON] Number of blocks the parameter value is ramped towards the next input sample */
+	int blockRamp;
 
 	struct InputConfig {
 		int channels;
@@ -47,9 +51,17 @@ struct CVMapModule : CVMapModuleBase<MAX_CHANNELS> {
 
 	dsp::ClockDivider processDivider;
 	dsp::ClockDivider lightDivider;
+	dsp::ClockDivider blockDivider;
 
 	ScaledMapParam<float> mapParam[MAX_CHANNELS];
 
+	/** Input sample at the start of the current ramp */
+	float blockFrom[MAX_CHANNELS];
+	/** Input sample at the end of the current ramp */
+	float blockTo[MAX_CHANNELS];
+	/** Number of blocks processed of the current ramp */
+	int blockRampPos = 0;
+
 	Module* expCtx = NULL;
 
 	CVMapModule() {
@@ -72,6 +84,8 @@ struct CVMapModule : CVMapModuleBase<MAX_CHANNELS> {
 			mapParam[i].reset();
 			mapInput[i] = i;
 		}
+		setBlockSize(1);
+		setBlockRamp(1);
 		for (size_t i = 0; i < 2; i++) {
 			inputConfig[i].hideUnused = true;
 			for (size_t j = 0; j < 16; j++) {
@@ -81,7 +95,12 @@ struct CVMapModule : CVMapModuleBase<MAX_CHANNELS> {
 	}
 
 	void process(const ProcessArgs& args) override {
-		if (audioRate || processDivider.process()) {
+		if (audioRate && blockSize > 1) {
+			if (blockDivider.process()) {
+				processBlock(args.sampleTime * blockSize);
+			}
+		}
+		else if (audioRate || processDivider.process()) {
 			float deltaTime = args.sampleTime * (audioRate ? 1.f : float(processDivider.getDivision()));
 
 			// Step channels
@@ -90,14 +109,8 @@ struct CVMapModule : CVMapModuleBase<MAX_CHANNELS> {
 				if (paramQuantity == NULL) continue;
 				mapParam[i].setParamQuantity(paramQuantity);
 
-				Input in = mapInput[i] < 16 ? inputs[POLY_INPUT1] : inputs[POLY_INPUT2];
-				if (!in.isConnected()) continue;
-				int c = mapInput[i] % 16;
-				if (c >= in.getChannels()) continue;
-
-				float t = in.getVoltage(c);
-				if (bipolarInput) t += 5.f;
-				t /= 10.f;
+				float t;
+				if (!getInputValue(i, t)) continue;
 
 				// Set a new value for the mapped parameter
 				mapParam[i].setValue(t);
@@ -142,6 +155,75 @@ struct CVMapModule : CVMapModuleBase<MAX_CHANNELS> {
 		}
 	}
 
+	/** Writes the mapped parameters once per block, the inputs are sampled at the start of every ramp */
+	void processBlock(float deltaTime) {
+		bool rampStart = blockRampPos == 0;
+		float rampPhase = float(blockRampPos + 1) / float(blockRamp);
+
+		for (int i = 0; i < mapLen; i++) {
+			ParamQuantity* paramQuantity = getParamQuantity(i);
+			if (paramQuantity == NULL) continue;
+			mapParam[i].setParamQuantity(paramQuantity);
+
+			if (rampStart) {
+				float t;
+				if (!getInputValue(i, t)) {
+					blockTo[i] = std::numeric_limits<float>::infinity();
+					continue;
+				}
+				// Start from the input's current value if there was no previous ramp
+				blockFrom[i] = blockTo[i] == std::numeric_limits<float>::infinity() ? t : blockTo[i];
+				blockTo[i] = t;
+			}
+			if (blockTo[i] == std::numeric_limits<float>::infinity()) continue;
+
+			mapParam[i].setValue(crossfade(blockFrom[i], blockTo[i], rampPhase));
+			mapParam[i].process(deltaTime, lockParameterChanges);
+		}
+
+		blockRampPos = (blockRampPos + 1) % blockRamp;
+	}
+
+	/** Reads the normalized input value of map i, returns false if the input channel is not available */
+	bool getInputValue(int i, float& t) {
+		Input& in = mapInput[i] < 16 ? inputs[POLY_INPUT1] : inputs[POLY_INPUT2];
+		if (!in.isConnected()) return false;
+		int c = mapInput[i] % 16;
+		if (c >= in.getChannels()) return false;
+
+		t = in.getVoltage(c);
+		if (bipolarInput) t += 5.f;
+		t /= 10.f;
+		return true;
+	}
+
+	void setBlockSize(int blockSize) {
+		this->blockSize = blockSize;
+		blockDivider.setDivision(blockSize);
+		blockDivider.reset();
+		resetBlockRamp();
+	}
+
+	void setBlockRamp(int blockRamp) {
+		this->blockRamp = blockRamp;
+		resetBlockRamp();
+	}
+
+	void resetBlockRamp() {
+		blockRampPos = 0;
+		for (int i = 0; i < MAX_CHANNELS; i++) {
+			blockTo[i] = std::numeric_limits<float>::infinity();
+		}
+	}
+
+	/** Returns the highest modulation frequency (in Hz) the mapped parameters can follow */
+	float getModulationBandwidth(float sampleRate) {
+		if (!audioRate) return sampleRate / processDivider.getDivision() / 2.f;
+		// The inputs are sampled once per ramp, single-sample blocks don't ramp
+		int ramp = blockSize > 1 ? blockRamp : 1;
+		return sampleRate / (blockSize * ramp) / 2.f;
+	}
+
 	int getEmptySlotId() {
 		int i = -1;
 		// Find next incomplete map
@@ -157,6 +239,8 @@ struct CVMapModule : CVMapModuleBase<MAX_CHANNELS> {
 		json_object_set_new(rootJ, "panelTheme", json_integer(panelTheme));
 		json_object_set_new(rootJ, "audioRate", json_boolean(audioRate));
 		json_object_set_new(rootJ, "locked", json_boolean(locked));
+		json_object_set_new(rootJ, "blockSize", json_integer(blockSize));
+		json_object_set_new(rootJ, "blockRamp", json_integer(blockRamp));
 
 		json_t* inputConfigsJ = json_array();
 		for (size_t i = 0; i < 2; i++) {
@@ -189,6 +273,10 @@ struct CVMapModule : CVMapModuleBase<MAX_CHANNELS> {
 		if (audioRateJ) audioRate = json_boolean_value(audioRateJ);
 		json_t* lockedJ = json_object_get(rootJ, "locked");
 		if (lockedJ) locked = json_boolean_value(lockedJ);
+		json_t* blockSizeJ = json_object_get(rootJ, "blockSize");
+		if (blockSizeJ) setBlockSize(std::max((int)json_integer_value(blockSizeJ), 1));
+		json_t* blockRampJ = json_object_get(rootJ, "blockRamp");
+		if (blockRampJ) setBlockRamp(std::max((int)json_integer_value(blockRampJ), 1));
 
 		json_t* inputConfigsJ = json_object_get(rootJ, "inputConfig");
 		if (inputConfigsJ) {
@@ -464,6 +552,71 @@ struct CVMapWidget : ThemedModuleWidget<CVMapModule>, ParamWidgetContextExtender
 			}
 		};
 
+		struct BlockSizeMenuItem : MenuItem {
+			struct BlockSizeItem : MenuItem {
+				CVMapModule* module;
+				int blockSize;
+				void onAction(const event::Action& e) override {
+					module->setBlockSize(blockSize);
+				}
+				void step() override {
+					rightText = module->blockSize == blockSize ? "✔" : "";
+					MenuItem::step();
+				}
+			};
+
+			CVMapModule* module;
+			BlockSizeMenuItem() {
+				rightText = RIGHT_ARROW;
+			}
+
+			Menu* createChildMenu() override {
+				Menu* menu = new Menu;
+				menu->addChild(construct<BlockSizeItem>(&MenuItem::text, "Every sample", &BlockSizeItem::module, module, &BlockSizeItem::blockSize, 1));
+				for (int b : {4, 8, 16, 32, 64}) {
+					menu->addChild(construct<BlockSizeItem>(&MenuItem::text, string::f("%i samples", b), &BlockSizeItem::module, module, &BlockSizeItem::blockSize, b));
+				}
+				return menu;
+			}
+		};
+
+		struct BlockRampMenuItem : MenuItem {
+			struct BlockRampItem : MenuItem {
+				CVMapModule* module;
+				int blockRamp;
+				void onAction(const event::Action& e) override {
+					module->setBlockRamp(blockRamp);
+				}
+				void step() override {
+					rightText = module->blockRamp == blockRamp ? "✔" : "";
+					MenuItem::step();
+				}
+			};
+
+			CVMapModule* module;
+			BlockRampMenuItem() {
+				rightText = RIGHT_ARROW;
+			}
+
+			Menu* createChildMenu() override {
+				Menu* menu = new Menu;
+				menu->addChild(construct<BlockRampItem>(&MenuItem::text, "Off", &BlockRampItem::module, module, &BlockRampItem::blockRamp, 1));
+				for (int r : {2, 4, 8}) {
+					menu->addChild(construct<BlockRampItem>(&MenuItem::text, string::f("%i blocks", r), &BlockRampItem::module, module, &BlockRampItem::blockRamp, r));
+				}
+				return menu;
+			}
+		};
+
+		struct BandwidthLabel : MenuLabel {
+			CVMapModule* module;
+			void step() override {
+				float f = module->getModulationBandwidth(APP->engine->getSampleRate());
+				text = f >= 1000.f ? string::f("Modulation bandwidth %.1f kHz", f / 1000.f) : string::f("Modulation bandwidth %.0f Hz", f);
+				MenuLabel::step();
+			}
+		};
+
 		struct TextScrollItem : MenuItem {
 			CVMapModule* module;
 			void onAction(const event::Action& e) override {
@@ -501,6 +654,9 @@ struct CVMapWidget : ThemedModuleWidget<CVMapModule>, ParamWidgetContextExtender
 		menu->addChild(construct<LockItem>(&MenuItem::text, "Parameter changes", &LockItem::module, module));
 		menu->addChild(construct<UniBiItem>(&MenuItem::text, "Signal input", &UniBiItem::module, module));
 		menu->addChild(construct<AudioRateItem>(&MenuItem::text, "Audio rate processing", &AudioRateItem::module, module));
+		menu->addChild(construct<BlockSizeMenuItem>(&MenuItem::text, "Audio rate block size", &BlockSizeMenuItem::module, module, &BlockSizeMenuItem::disabled, !module->audioRate));
+		menu->addChild(construct<BlockRampMenuItem>(&MenuItem::text, "Audio rate block ramp", &BlockRampMenuItem::module, module, &BlockRampMenuItem::disabled, !module->audioRate || module->blockSize == 1));
+		menu->addChild(construct<BandwidthLabel>(&BandwidthLabel::module, module));
 		menu->addChild(new MenuSeparator());
 		menu->addChild(construct<TextScrollItem>(&MenuItem::text, "Text scrolling", &TextScrollItem::module, module));
 		menu->addChild(construct<MappingIndicatorHiddenItem>(&MenuItem::text, "Hide mapping indicators", &MappingIndicatorHiddenItem::module, module));
@@ -1,5 +1,6 @@
 #include "plugin.hpp"
 #include "MapModuleBase.hpp"
+#include "digital.hpp"
 #include <chrono>
 
 namespace StoermelderPackOne {
@@ -34,6 +35,11 @@ struct CVPamModule : MapModuleBase<MAX_CHANNELS> {
 	/** [Stored to JSON] */
 	bool locked;
 	
+	/** Scaled values of all mapped parameters, gathered for SIMD processing */
+	alignas(16) float scaledValues[MAX_CHANNELS];
+	/** The smoothing processor of each group of four channels */
+	ExponentialFilter4 valueFilters4[MAX_CHANNELS / 4];
+
 	dsp::ClockDivider processDivider;
 	dsp::ClockDivider lightDivider;
 
@@ -56,31 +62,50 @@ struct CVPamModule : MapModuleBase<MAX_CHANNELS> {
 		MapModuleBase<MAX_CHANNELS>::onReset();
 	}
 
+	void clearMap(int id) override {
+		valueFilters4[id / 4].reset(id % 4);
+		MapModuleBase<MAX_CHANNELS>::clearMap(id);
+	}
+
+	void clearMaps() override {
+		for (int i = 0; i < MAX_CHANNELS / 4; i++) {
+			valueFilters4[i].reset();
+		}
+		MapModuleBase<MAX_CHANNELS>::clearMaps();
+	}
+
 	void process(const ProcessArgs& args) override {
 		if (audioRate || processDivider.process()) {
 			int channelCount1 = 0;
 			int channelCount2 = 0;
 
-			// Step channels
-			for (int i = 0; i < mapLen; i++) {
+			// Gather channels, unmapped slots hold their last value
+			int blockCount = (mapLen + 3) / 4;
+			for (int i = 0; i < blockCount * 4; i++) {
 				ParamQuantity* paramQuantity = getParamQuantity(i);
-				if (!paramQuantity) continue;
+				if (!paramQuantity) {
+					scaledValues[i] = valueFilters4[i / 4].out[i % 4];
+					continue;
+				}
 
 				if (i < 16)
 					channelCount1 = i + 1;
 				if (i >= 16)
 					channelCount2 = i - 16 + 1;
 
-				// Set voltage
-				float v = paramQuantity->getScaledValue();
-				v = valueFilters[i].process(args.sampleTime, v);
-				v = rescale(v, 0.f, 1.f, 0.f, 10.f);
-				if (bipolarOutput)
-					v -= 5.f;
-				if (i < 16) 
-					outputs[POLY_OUTPUT1].setVoltage(v, i);
-				else 
-					outputs[POLY_OUTPUT2].setVoltage(v, i - 16);
+				scaledValues[i] = paramQuantity->getScaledValue();
+			}
+
+			// Set voltages, four channels at once
+			simd::float_4 offset = bipolarOutput ? 5.f : 0.f;
+			for (int c = 0; c < blockCount; c++) {
+				simd::float_4 v = simd::float_4::load(&scaledValues[c * 4]);
+				v = valueFilters4[c].process(args.sampleTime, v);
+				v = v * 10.f - offset;
+				if (c < 4)
+					outputs[POLY_OUTPUT1].setVoltageSimd(v, c * 4);
+				else
+					outputs[POLY_OUTPUT2].setVoltageSimd(v, c * 4 - 16);
 			}
 			
 			outputs[POLY_OUTPUT1].setChannels(channelCount1);
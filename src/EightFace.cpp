@@ -86,6 +86,8 @@ struct EightFaceModule : Module {
 	int presetCount = NUM_PRESETS;
 	/** [Stored to JSON] */
 	AUTOLOAD autoload = AUTOLOAD::OFF;
+	/** [Stored to JSON] Decode the armed preset before it is loaded */
+	bool prewarm = false;
 
 	/** [Stored to JSON] mode for SEQ CV input */
 	SLOTCVMODE slotCvMode = SLOTCVMODE::TRIG_FWD;
@@ -107,11 +109,21 @@ struct EightFaceModule : Module {
 	std::thread* worker;
 	bool workerIsRunning = true;
 	bool workerDoProcess = false;
+	bool workerDoLoad = false;
 	int workerPreset = -1;
+	int workerPrewarm = -1;
 	ModuleWidget* workerModuleWidget;
 	bool workerGui = false;
 	ModuleWidget* workerGuiModuleWidget = NULL;
 
+	/** Parameter values of preset slot warmPreset, decoded by the worker */
+	PresetParams warmParams;
+	int warmPreset = -1;
+
+	LatencyHistogram latencySave;
+	LatencyHistogram latencyLoad;
+	LatencyHistogram latencyGui;
+
 	LongPressButton typeButtons[NUM_PRESETS];
 	dsp::SchmittTrigger slotTrigger;
 	dsp::SchmittTrigger resetTrigger;
@@ -162,6 +174,7 @@ struct EightFaceModule : Module {
 		presetCount = NUM_PRESETS;
 		presetPrev = -1;
 		presetNext = -1;
+		warmPreset = -1;
 		modelSlug = "";
 		pluginSlug = "";
 		realModelSlug = "";
@@ -169,6 +182,7 @@ struct EightFaceModule : Module {
 		moduleName = "";
 		connected = 0;
 		autoload = AUTOLOAD::OFF;
+		prewarm = false;
 	}
 
 	void process(const ProcessArgs& args) override {
@@ -353,25 +367,73 @@ struct EightFaceModule : Module {
 		while (true) {
 			std::unique_lock<std::mutex> lock(workerMutex);
 			workerCondVar.wait(lock, std::bind(&EightFaceModule::workerDoProcess, this));
-			if (!workerIsRunning || workerPreset < 0) return;
-			if (ctrlMode == CTRLMODE::AUTO && presetPrev >= 0 && presetSlotUsed[presetPrev]) {
-				json_decref(presetSlot[presetPrev]);
-				presetSlot[presetPrev] = workerModuleWidget->toJson();
-			}
-			workerModuleWidget->fromJson(presetSlot[workerPreset]);
+			if (!workerIsRunning) return;
 			workerDoProcess = false;
+
+			if (workerDoLoad) {
+				workerDoLoad = false;
+				presetApply(workerModuleWidget);
+			}
+
+			if (workerPrewarm >= 0) {
+				int p = workerPrewarm;
+				workerPrewarm = -1;
+				if (presetSlotUsed[p]) {
+					warmPreset = -1;
+					warmParams.decode(presetSlot[p]);
+					warmPreset = p;
+				}
+			}
 		}
 	}
 
 	void processGui() {
 		if (workerGuiModuleWidget) {
-			if (ctrlMode == CTRLMODE::AUTO && presetPrev >= 0 && presetSlotUsed[presetPrev]) {
+			auto t = std::chrono::steady_clock::now();
+			presetApply(workerGuiModuleWidget);
+			workerGuiModuleWidget = NULL;
+			latencyGui.add(t);
+		}
+	}
+
+	/**
+	 * Stores the AUTO snapshot and loads the selected preset. If the module's data matches
+	 * the stored state only the parameter values are written in either direction, using
+	 * the pre-warmed values if available.
+	 */
+	void presetApply(ModuleWidget* mw) {
+		Module* m = mw->module;
+		auto t = std::chrono::steady_clock::now();
+		json_t* dataJ = m->dataToJson();
+
+		if (ctrlMode == CTRLMODE::AUTO && presetPrev >= 0 && presetSlotUsed[presetPrev]) {
+			if (warmPreset == presetPrev) warmPreset = -1;
+			if (presetParamsOnly(m, dataJ, presetSlot[presetPrev])) {
+				presetSaveParams(m, presetSlot[presetPrev]);
+			}
+			else {
 				json_decref(presetSlot[presetPrev]);
-				presetSlot[presetPrev] = workerModuleWidget->toJson();
+				presetSlot[presetPrev] = mw->toJson();
+			}
+			latencySave.add(t);
+			t = std::chrono::steady_clock::now();
+		}
+
+		json_t* presetJ = presetSlot[workerPreset];
+		if (presetParamsOnly(m, dataJ, presetJ)) {
+			if (warmPreset == workerPreset) {
+				warmParams.apply(m);
+			}
+			else {
+				presetLoadParams(m, presetJ);
 			}
-			workerGuiModuleWidget->fromJson(presetSlot[workerPreset]);
-			workerGuiModuleWidget = NULL;
 		}
+		else {
+			mw->fromJson(presetJ);
+		}
+		latencyLoad.add(t);
+
+		if (dataJ) json_decref(dataJ);
 	}
 
 	void presetLoad(Module* m, int p, bool isNext = false, bool force = false) {
@@ -391,6 +453,7 @@ struct EightFaceModule : Module {
 				}
 				else {
 					workerModuleWidget = mw;
+					workerDoLoad = true;
 					workerDoProcess = true;
 					workerCondVar.notify_one();
 				}
@@ -399,6 +462,11 @@ struct EightFaceModule : Module {
 		else {
 			if (!presetSlotUsed[p]) return;
 			presetNext = p;
+			if (prewarm && p != warmPreset) {
+				workerPrewarm = p;
+				workerDoProcess = true;
+				workerCondVar.notify_one();
+			}
 		}
 	}
 
@@ -412,12 +480,16 @@ struct EightFaceModule : Module {
 		workerGui = it != guiModuleSlugs.end();
 
 		ModuleWidget* mw = APP->scene->rack->getModule(m->id);
+		if (warmPreset == p) warmPreset = -1;
 		if (presetSlotUsed[p]) json_decref(presetSlot[p]);
 		presetSlotUsed[p] = true;
+		auto t = std::chrono::steady_clock::now();
 		presetSlot[p] = mw->toJson();
+		latencySave.add(t);
 	}
 
 	void presetClear(int p) {
+		if (warmPreset == p) warmPreset = -1;
 		if (presetSlotUsed[p])
 			json_decref(presetSlot[p]);
 		presetSlot[p] = NULL;
@@ -452,6 +524,7 @@ struct EightFaceModule : Module {
 		json_object_set_new(rootJ, "slotCvMode", json_integer((int)slotCvMode));
 		json_object_set_new(rootJ, "preset", json_integer(preset));
 		json_object_set_new(rootJ, "presetCount", json_integer(presetCount));
+		json_object_set_new(rootJ, "prewarm", json_boolean(prewarm));
 
 		json_t* presetsJ = json_array();
 		for (int i = 0; i < NUM_PRESETS; i++) {
@@ -486,7 +559,9 @@ struct EightFaceModule : Module {
 		slotCvMode = (SLOTCVMODE)json_integer_value(json_object_get(rootJ, "slotCvMode"));
 		preset = json_integer_value(json_object_get(rootJ, "preset"));
 		presetCount = json_integer_value(json_object_get(rootJ, "presetCount"));
+		prewarm = json_boolean_value(json_object_get(rootJ, "prewarm"));
 
+		warmPreset = -1;
 		for (int i = 0; i < NUM_PRESETS; i++) {
 			if (presetSlotUsed[i]) {
 				json_decref(presetSlot[i]);
@@ -612,6 +687,58 @@ struct SideItem : MenuItem {
 	}
 };
 
+template < typename MODULE >
+struct PrewarmItem : MenuItem {
+	MODULE* module;
+	void onAction(const event::Action& e) override {
+		module->prewarm ^= true;
+	}
+	void step() override {
+		rightText = CHECKMARK(module->prewarm);
+		MenuItem::step();
+	}
+};
+
+template < typename MODULE >
+struct LatencyMenuItem : MenuItem {
+	struct CopyItem : MenuItem {
+		MODULE* module;
+		void onAction(const event::Action& e) override {
+			json_t* rootJ = json_object();
+			json_object_set_new(rootJ, "moduleName", json_string(module->moduleName.c_str()));
+			json_object_set_new(rootJ, "save", module->latencySave.toJson());
+			json_object_set_new(rootJ, "load", module->latencyLoad.toJson());
+			json_object_set_new(rootJ, "guiQueue", module->latencyGui.toJson());
+			latencyCopyClipboard(rootJ);
+		}
+	};
+
+	struct ResetItem : MenuItem {
+		MODULE* module;
+		void onAction(const event::Action& e) override {
+			module->latencySave.reset();
+			module->latencyLoad.reset();
+			module->latencyGui.reset();
+		}
+	};
+
+	MODULE* module;
+	LatencyMenuItem() {
+		rightText = RIGHT_ARROW;
+	}
+
+	Menu* createChildMenu() override {
+		Menu* menu = new Menu;
+		menu->addChild(construct<LatencyHistogramItem>(&MenuItem::text, "Save", &LatencyHistogramItem::histogram, &module->latencySave));
+		menu->addChild(construct<LatencyHistogramItem>(&MenuItem::text, "Load", &LatencyHistogramItem::histogram, &module->latencyLoad));
+		menu->addChild(construct<LatencyHistogramItem>(&MenuItem::text, "GUI queue", &LatencyHistogramItem::histogram, &module->latencyGui));
+		menu->addChild(new MenuSeparator);
+		menu->addChild(construct<CopyItem>(&MenuItem::text, "Copy as JSON", &CopyItem::module, module));
+		menu->addChild(construct<ResetItem>(&MenuItem::text, "Reset", &ResetItem::module, module));
+		return menu;
+	}
+};
+
 
 struct WhiteRedLight : GrayModuleLightWidget {
 	WhiteRedLight() {
@@ -643,6 +770,8 @@ struct EightFaceWidgetTemplate : ModuleWidget {
 		menu->addChild(construct<SlovCvModeMenuItem<MODULE>>(&MenuItem::text, "Port SLOT mode", &SlovCvModeMenuItem<MODULE>::module, module));
 		menu->addChild(construct<SideItem<MODULE>>(&MenuItem::text, "Module", &SideItem<MODULE>::module, module));
 		menu->addChild(construct<AutoloadMenuItem<MODULE>>(&MenuItem::text, "Autoload", &AutoloadMenuItem<MODULE>::module, module));
+		menu->addChild(construct<PrewarmItem<MODULE>>(&MenuItem::text, "Pre-warm armed preset", &PrewarmItem<MODULE>::module, module));
+		menu->addChild(construct<LatencyMenuItem<MODULE>>(&MenuItem::text, "Switching latency", &LatencyMenuItem<MODULE>::module, module));
 	}
 
 	void onHoverKey(const event::HoverKey& e) override {
@@ -1,4 +1,6 @@
 #pragma once
+#include <atomic>
+
 namespace StoermelderPackOne {
 namespace EightFace {
 
@@ -26,5 +28,196 @@ enum class AUTOLOAD {
 	LASTACTIVE = 2
 };
 
+/**
+ * Returns true if a stored module state differs from the module at most in its parameter values.
+ * dataJ is the current result of the module's dataToJson().
+ */
+inline bool presetParamsOnly(Module* m, json_t* dataJ, json_t* moduleJ) {
+	json_t* bypassJ = json_object_get(moduleJ, "bypass");
+	if ((bypassJ && json_boolean_value(bypassJ)) != m->bypass) return false;
+	json_t* storedJ = json_object_get(moduleJ, "data");
+	if (!dataJ || !storedJ) return !dataJ && !storedJ;
+	return json_equal(dataJ, storedJ);
+}
+
+/** Hash of the data of a module state as returned by dataToJson(), used for comparing without keeping the JSON */
+inline size_t presetDataHash(json_t* dataJ) {
+	if (!dataJ) return 0;
+	char* data = json_dumps(dataJ, JSON_COMPACT | JSON_SORT_KEYS);
+	if (!data) return 0;
+	DEFER({
+		free(data);
+	});
+	return std::hash<std::string>()(data);
+}
+
+/** Sets the parameters of a module to the values of a stored module state */
+inline void presetLoadParams(Module* m, json_t* moduleJ) {
+	json_t* paramsJ = json_object_get(moduleJ, "params");
+	json_t* paramJ;
+	size_t paramIndex;
+	json_array_foreach(paramsJ, paramIndex, paramJ) {
+		json_t* paramIdJ = json_object_get(paramJ, "id");
+		size_t paramId = paramIdJ ? json_integer_value(paramIdJ) : paramIndex;
+		json_t* valueJ = json_object_get(paramJ, "value");
+		if (!valueJ || paramId >= m->params.size()) continue;
+		m->params[paramId].setValue(json_number_value(valueJ));
+	}
+}
+
+/** Parameter values of a stored module state, decoded into flat arrays ahead of use */
+struct PresetParams {
+	std::vector<int> ids;
+	std::vector<float> values;
+
+	void clear() {
+		ids.clear();
+		values.clear();
+	}
+
+	void decode(json_t* moduleJ) {
+		clear();
+		json_t* paramsJ = json_object_get(moduleJ, "params");
+		json_t* paramJ;
+		size_t paramIndex;
+		json_array_foreach(paramsJ, paramIndex, paramJ) {
+			json_t* valueJ = json_object_get(paramJ, "value");
+			if (!valueJ) continue;
+			json_t* paramIdJ = json_object_get(paramJ, "id");
+			ids.push_back(paramIdJ ? json_integer_value(paramIdJ) : paramIndex);
+			values.push_back(json_number_value(valueJ));
+		}
+	}
+
+	void apply(Module* m) {
+		for (size_t i = 0; i < ids.size(); i++) {
+			int paramId = ids[i];
+			if (paramId < 0 || paramId >= (int)m->params.size()) continue;
+			m->params[paramId].setValue(values[i]);
+		}
+	}
+};
+
+/** Updates the parameter values of a stored module state in place */
+inline void presetSaveParams(Module* m, json_t* moduleJ) {
+	json_t* paramsJ = json_object_get(moduleJ, "params");
+	json_t* paramJ;
+	size_t paramIndex;
+	json_array_foreach(paramsJ, paramIndex, paramJ) {
+		json_t* paramIdJ = json_object_get(paramJ, "id");
+		size_t paramId = paramIdJ ? json_integer_value(paramIdJ) : paramIndex;
+		if (paramId >= m->params.size()) continue;
+		json_object_set_new(paramJ, "value", json_real(m->params[paramId].getValue()));
+	}
+}
+
+/**
+ * Histogram of the durations of preset operations, buckets double in width.
+ * The counters are atomic as the worker adds to them while the GUI thread reads and resets them.
+ */
+struct LatencyHistogram {
+	static const int BUCKETS = 12;
+	/** Upper bound of the first bucket in seconds */
+	static constexpr float BUCKET_MIN = 1e-4f;
+
+	std::atomic<uint32_t> counts[BUCKETS];
+	std::atomic<uint32_t> total;
+	std::atomic<float> sum;
+	std::atomic<float> max;
+
+	LatencyHistogram() {
+		reset();
+	}
+
+	void reset() {
+		for (int i = 0; i < BUCKETS; i++) {
+			counts[i] = 0;
+		}
+		total = 0;
+		sum = 0.f;
+		max = 0.f;
+	}
+
+	/** Returns the seconds passed since start */
+	static float since(std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	void add(std::chrono::steady_clock::time_point start) {
+		add(since(start));
+	}
+
+	void add(float t) {
+		int i = 0;
+		while (i < BUCKETS - 1 && t > bucketLimit(i)) i++;
+		counts[i]++;
+		total++;
+		float s = sum.load();
+		while (!sum.compare_exchange_weak(s, s + t));
+		float m = max.load();
+		while (m < t && !max.compare_exchange_weak(m, t));
+	}
+
+	float bucketLimit(int i) {
+		return BUCKET_MIN * float(1 << i);
+	}
+
+	std::string toString() {
+		uint32_t n = total;
+		if (n == 0) return "-";
+		return string::f("%u× avg %.2fms max %.2fms", n, sum / n * 1000.f, max * 1000.f);
+	}
+
+	json_t* toJson() {
+		uint32_t n = total;
+		json_t* rootJ = json_object();
+		json_object_set_new(rootJ, "count", json_integer(n));
+		json_object_set_new(rootJ, "mean", json_real(n > 0 ? sum / n : 0.f));
+		json_object_set_new(rootJ, "max", json_real(max));
+		json_t* bucketsJ = json_array();
+		for (int i = 0; i < BUCKETS; i++) {
+			json_t* bucketJ = json_object();
+			json_object_set_new(bucketJ, "upTo", i < BUCKETS - 1 ? json_real(bucketLimit(i)) : json_null());
+			json_object_set_new(bucketJ, "count", json_integer(counts[i].load()));
+			json_array_append_new(bucketsJ, bucketJ);
+		}
+		json_object_set_new(rootJ, "buckets", bucketsJ);
+		return rootJ;
+	}
+};
+
+/** Context menu item showing a histogram in its submenu */
+struct LatencyHistogramItem : MenuItem {
+	LatencyHistogram* histogram;
+
+	void step() override {
+		rightText = histogram->toString() + " " + RIGHT_ARROW;
+		MenuItem::step();
+	}
+
+	Menu* createChildMenu() override {
+		Menu* menu = new Menu;
+		for (int i = 0; i < LatencyHistogram::BUCKETS; i++) {
+			std::string text = i < LatencyHistogram::BUCKETS - 1 ?
+				string::f("≤ %.1fms", histogram->bucketLimit(i) * 1000.f) :
+				string::f("> %.1fms", histogram->bucketLimit(i - 1) * 1000.f);
+			menu->addChild(construct<MenuLabel>(&MenuLabel::text, string::f("%s: %u", text.c_str(), histogram->counts[i].load())));
+		}
+		return menu;
+	}
+};
+
+/** Copies a JSON object to the clipboard and releases it */
+inline void latencyCopyClipboard(json_t* rootJ) {
+	DEFER({
+		json_decref(rootJ);
+	});
+	char* json = json_dumps(rootJ, JSON_INDENT(2) | JSON_REAL_PRECISION(9));
+	DEFER({
+		free(json);
+	});
+	glfwSetClipboardString(APP->window->win, json);
+}
+
 } // namespace EightFace
 } // namespace StoermelderPackOne
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <functional>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
 #include <random>
 
 namespace StoermelderPackOne {
@@ -110,6 +111,8 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 		std::string moduleName;
 		ModuleWidget* getModuleWidget() { return APP->scene->rack->getModule(moduleId); }
 		bool needsGuiThread = false;
+		EightFace::LatencyHistogram latencySave;
+		EightFace::LatencyHistogram latencyLoad;
 	};
 
 	/** [Stored to JSON] */
@@ -117,18 +120,47 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 	/** [Stored to JSON] */
 	EightFace::AUTOLOAD autoload = EightFace::AUTOLOAD::OFF;
 
+	/** [Stored to JSON] Apply snapshots from compiled parameter arrays */
+	bool fastSwitch;
+	/** [Stored to JSON] Decode the parameters of the armed snapshot before it is loaded */
+	bool prewarm;
+
 	/** [Stored to JSON] */
 	bool boxDraw;
 	/** [Stored to JSON] */
 	NVGcolor boxColor;
 
+	/** Captured module states waiting for the modules bound to the GUI thread before being stored */
+	struct PendingCapture {
+		int p;
+		uint32_t version;
+		std::vector<json_t*> states;
+	};
+
+	/** Module state of a snapshot to be loaded without the slots locked, holds its own reference to the JSON */
+	struct PendingLoad {
+		EightFaceMk2PlanItem item;
+		/** Set if the parameters may be written without loading the full JSON */
+		bool compiled;
+	};
+
+	/** Guards the requests to the worker, it is only held while handing them over */
 	std::mutex workerMutex;
 	std::condition_variable workerCondVar;
 	std::thread* worker;
 	bool workerIsRunning = true;
 	bool workerDoProcess = false;
+	bool workerDoLoad = false;
 	int workerPreset = -1;
+	int workerPrewarm = -1;
+	/** Save and clear requests of the engine thread and saves of the context menu, handled by the worker */
+	dsp::RingBuffer<std::tuple<SLOT_CMD, int>, 64> workerSlotQueue;
+	/** Filled by the worker and drained by the GUI thread, both with the slots locked, as is workerGuiQueue */
+	dsp::RingBuffer<PendingCapture*, 16> workerCaptureQueue;
 	dsp::RingBuffer<std::tuple<ModuleWidget*, json_t*>, 16> workerGuiQueue;
+	/** Set by the worker if processGui() has work queued */
+	std::atomic<bool> workerGuiPending{false};
+	EightFace::LatencyHistogram latencyGui;
 
 
 	EightFaceMk2Module() {
@@ -146,9 +178,12 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 			BASE::slot[i].lights = &Module::lights[LIGHT_PRESET + i * 3];
 			BASE::slot[i].presetSlotUsed = &BASE::presetSlotUsed[i];
 			BASE::slot[i].preset = &BASE::preset[i];
+			BASE::slot[i].plan = &BASE::plan[i];
 			BASE::slot[i].presetButton = &BASE::presetButton[i];
 		}
 
+		presetTotal = NUM_PRESETS;
+		N[0] = this;
 		buttonDivider.setDivision(128);
 		boundModulesDivider.setDivision(APP->engine->getSampleRate());
 		lightDivider.setDivision(512);
@@ -157,6 +192,26 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 	}
 
 	~EightFaceMk2Module() {
+		{
+			std::lock_guard<std::mutex> lock(workerMutex);
+			workerIsRunning = false;
+			workerDoProcess = true;
+			workerCondVar.notify_one();
+		}
+		worker->join();
+		delete worker;
+
+		while (!workerCaptureQueue.empty()) {
+			PendingCapture* c = workerCaptureQueue.shift();
+			for (json_t* vJ : c->states) {
+				json_decref(vJ);
+			}
+			delete c;
+		}
+		while (!workerGuiQueue.empty()) {
+			json_decref(std::get<1>(workerGuiQueue.shift()));
+		}
+
 		for (int i = 0; i < NUM_PRESETS; i++) {
 			if (BASE::presetSlotUsed[i]) {
 				for (json_t* vJ : BASE::preset[i]) {
@@ -167,30 +222,29 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 		for (BoundModule* b : boundModules) {
 			delete b;
 		}
-
-		workerIsRunning = false;
-		workerDoProcess = true;
-		workerCondVar.notify_one();
-		worker->join();
-		delete worker;
 	}
 
 	void onReset() override {
 		inChange = true;
-		for (int i = 0; i < NUM_PRESETS; i++) {
-			if (BASE::presetSlotUsed[i]) {
-				for (json_t* vJ : BASE::preset[i]) {
-					json_decref(vJ);
+		{
+			std::lock_guard<std::mutex> lock(BASE::slotMutex);
+			for (int i = 0; i < NUM_PRESETS; i++) {
+				if (BASE::presetSlotUsed[i]) {
+					for (json_t* vJ : BASE::preset[i]) {
+						json_decref(vJ);
+					}
+					BASE::preset[i].clear();
 				}
-				BASE::preset[i].clear();
+				BASE::presetSlotUsed[i] = false;
+				BASE::textLabel[i] = "";
+				BASE::plan[i].clear();
+				BASE::slot[i].version++;
 			}
-			BASE::presetSlotUsed[i] = false;
-			BASE::textLabel[i] = "";
-		}
-		for (BoundModule* b : boundModules) {
-			delete b;
+			for (BoundModule* b : boundModules) {
+				delete b;
+			}
+			boundModules.clear();
 		}
-		boundModules.clear();
 		inChange = false;
 
 		preset = -1;
@@ -198,6 +252,8 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 		presetNext = -1;
 
 		autoload = EightFace::AUTOLOAD::OFF;
+		fastSwitch = false;
+		prewarm = false;
 		boxDraw = true;
 		boxColor = color::BLUE;
 
@@ -238,7 +294,7 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 	void process(const Module::ProcessArgs& args) override {
 		if (inChange) return;
 
-		presetTotal = NUM_PRESETS;
+		int presetTotal = NUM_PRESETS;
 		Module* m = this;
 		EightFaceMk2Base<NUM_PRESETS>* t = this;
 		t->ctrlMode = (CTRLMODE)Module::params[PARAM_RW].getValue();
@@ -260,6 +316,7 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 			t->ctrlMode = BASE::ctrlMode;
 			presetTotal += NUM_PRESETS;
 		}
+		this->presetTotal = presetTotal;
 		int presetCount = std::min(this->presetCount, presetTotal);
 
 		// Read mode
@@ -387,9 +444,9 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 						case LongPressButton::NO_PRESS:
 							break;
 						case LongPressButton::SHORT_PRESS:
-							presetSave(i); break;
+							presetRequest(SLOT_CMD::SAVE, i); break;
 						case LongPressButton::LONG_PRESS:
-							presetClear(i); break;
+							presetRequest(SLOT_CMD::CLEAR, i); break;
 					}
 				}
 			}
@@ -422,8 +479,18 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 		}
 	}
 
+	/** Locks the slots of this module and all attached expanders, always in the order of the chain */
+	std::vector<std::unique_lock<std::mutex>> slotLock() {
+		std::vector<std::unique_lock<std::mutex>> locks;
+		for (int n = 0; n * NUM_PRESETS < presetTotal; n++) {
+			locks.emplace_back(N[n]->slotMutex);
+		}
+		return locks;
+	}
+
 	void bindModule(Module* m) {
 		if (!m) return;
+		auto locks = slotLock();
 		for (BoundModule* b : boundModules) if (b->moduleId == m->id) return;
 		BoundModule* b = new BoundModule;
 		b->moduleId = m->id;
@@ -443,6 +510,7 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 	}
 
 	void unbindModule(BoundModule* b) {
+		auto locks = slotLock();
 		for (int i = 0; i < presetTotal; i++) {
 			EightFaceMk2Slot* slot = expSlot(i);
 			for (auto it = std::begin(*slot->preset); it != std::end(*slot->preset); it++) {
@@ -450,11 +518,13 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 				if (!idJ) continue;
 				int id = json_integer_value(idJ);
 				if (id == b->moduleId) {
+					json_decref(*it);
 					slot->preset->erase(it);
 					break;
 				}
 			}
 			*(slot->presetSlotUsed) = slot->preset->size() > 0;
+			slot->plan->clear();
 		}
 		for (auto it = std::begin(boundModules); it != std::end(boundModules); it++) {
 			if ((*it)->moduleId == b->moduleId) {
@@ -475,7 +545,9 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 				preset = p;
 				presetNext = -1;
 				if (!*(slot->presetSlotUsed)) return;
+				std::lock_guard<std::mutex> lock(workerMutex);
 				workerPreset = p;
+				workerDoLoad = true;
 				workerDoProcess = true;
 				workerCondVar.notify_one();
 			}
@@ -483,16 +555,118 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 		else {
 			if (!*(slot->presetSlotUsed)) return;
 			presetNext = p;
+			if (fastSwitch && prewarm) {
+				std::lock_guard<std::mutex> lock(workerMutex);
+				workerPrewarm = p;
+				workerDoProcess = true;
+				workerCondVar.notify_one();
+			}
+		}
+	}
+
+	/** Hands a save or clear of slot p to the worker, called on the engine thread or from the context menu */
+	void presetRequest(SLOT_CMD cmd, int p) {
+		{
+			std::lock_guard<std::mutex> lock(workerMutex);
+			if (!workerSlotQueue.full()) workerSlotQueue.push(std::make_tuple(cmd, p));
+			workerDoProcess = true;
+			workerCondVar.notify_one();
 		}
+		if (cmd == SLOT_CMD::SAVE) preset = p;
+		else if (preset == p) preset = -1;
 	}
 
 	void processWorker() {
+		std::vector<std::tuple<SLOT_CMD, int>> requests;
 		while (true) {
 			std::unique_lock<std::mutex> lock(workerMutex);
 			workerCondVar.wait(lock, std::bind(&EightFaceMk2Module::workerDoProcess, this));
-			if (!workerIsRunning || workerPreset < 0) return;
+			if (!workerIsRunning) return;
+			workerDoProcess = false;
+
+			requests.clear();
+			while (!workerSlotQueue.empty()) {
+				requests.push_back(workerSlotQueue.shift());
+			}
+			int loadPreset = workerDoLoad ? workerPreset : -1;
+			int prewarmPreset = workerPrewarm;
+			workerDoLoad = false;
+			workerPrewarm = -1;
+			lock.unlock();
+
+			// Bound modules are never called with the slots locked: another 8FACE mk2 or +8 bound
+			// to this module locks its own slots when it is saved or loaded
+			std::vector<PendingCapture> captures;
+			std::vector<int> moduleIds;
+			{
+				auto locks = slotLock();
+				moduleIds = boundModuleIds(false);
+				for (std::tuple<SLOT_CMD, int>& r : requests) {
+					int p = std::get<1>(r);
+					if (std::get<0>(r) == SLOT_CMD::SAVE) {
+						EightFaceMk2Slot* slot = expSlot(p);
+						if (slot) captures.push_back(PendingCapture{p, ++slot->version, {}});
+					}
+					else {
+						presetClear(p);
+					}
+				}
+			}
+
+			std::vector<std::tuple<int, float>> latencySave;
+			for (PendingCapture& c : captures) {
+				c.states = presetCaptureStates(moduleIds, latencySave);
+			}
+
+			std::vector<PendingLoad> loads;
+			{
+				auto locks = slotLock();
+				latencyAdd(latencySave, false);
+				// Pending saves are stored first, a load of the same slot must see them
+				for (PendingCapture& c : captures) {
+					presetCapture(c);
+				}
+				EightFaceMk2Slot* slot = loadPreset >= 0 ? expSlot(loadPreset) : NULL;
+				if (slot) loads = presetLoadItems(slot);
+				if (prewarmPreset >= 0) presetPrewarm(prewarmPreset);
+			}
 
-			EightFaceMk2Slot* slot = expSlot(workerPreset);
+			if (loads.empty()) continue;
+			std::vector<std::tuple<int, float>> latencyLoad;
+			presetApply(loads, latencyLoad);
+			{
+				auto locks = slotLock();
+				latencyAdd(latencyLoad, true);
+				for (PendingLoad& l : loads) {
+					json_decref(l.item.moduleJ);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Compiles the armed snapshot if needed, so the next load does not need to decode the parameters.
+	 * The data of the bound modules is still compared when loading. Called with the slots locked.
+	 */
+	void presetPrewarm(int p) {
+		EightFaceMk2Slot* slot = expSlot(p);
+		if (!slot || !*(slot->presetSlotUsed)) return;
+		if (!slot->plan->valid) presetCompile(slot);
+	}
+
+	/**
+	 * Collects the module states of a slot for loading without the slots locked, each holding its own reference.
+	 * States of modules bound to the GUI thread are queued for processGui() instead. Called with the slots locked.
+	 */
+	std::vector<PendingLoad> presetLoadItems(EightFaceMk2Slot* slot) {
+		std::vector<PendingLoad> loads;
+		if (fastSwitch) {
+			if (!slot->plan->valid) presetCompile(slot);
+			for (EightFaceMk2PlanItem& item : slot->plan->items) {
+				loads.push_back(PendingLoad{item, true});
+			}
+		}
+		else {
 			for (json_t* vJ : *slot->preset) {
 				json_t* idJ = json_object_get(vJ, "id");
 				if (!idJ) continue;
@@ -502,53 +676,281 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 				for (BoundModule* b : boundModules) {
 					if (b->moduleId != moduleId) continue;
 					if (b->pluginSlug != plugin || b->modelSlug != model) break;
-					ModuleWidget* mw = b->getModuleWidget();
-					if (!mw) continue;
-
-					if (b->needsGuiThread) {
-						workerGuiQueue.push(std::make_tuple(mw, vJ));
-					}
-					else {
-						mw->fromJson(vJ);
-					}
+					EightFaceMk2PlanItem item = EightFaceMk2PlanItem();
+					item.moduleId = moduleId;
+					item.needsGuiThread = b->needsGuiThread;
+					item.moduleJ = vJ;
+					loads.push_back(PendingLoad{item, false});
 					break;
 				}
 			}
+		}
 
-			workerDoProcess = false;
+		for (auto it = loads.begin(); it != loads.end();) {
+			if (it->item.needsGuiThread) {
+				workerGuiPush(it->item.moduleId, it->item.moduleJ);
+				it = loads.erase(it);
+			}
+			else {
+				json_incref(it->item.moduleJ);
+				it++;
+			}
 		}
+		return loads;
 	}
 
-	void processGui() {
-		while (!workerGuiQueue.empty()) {
-			auto t = workerGuiQueue.shift();
-			ModuleWidget* mw = std::get<0>(t);
-			json_t* vJ = std::get<1>(t);
-			mw->fromJson(vJ);
+	/** Queues a module state for loading on the GUI thread, the queue keeps its own reference */
+	void workerGuiPush(int moduleId, json_t* vJ) {
+		ModuleWidget* mw = APP->scene->rack->getModule(moduleId);
+		if (!mw || workerGuiQueue.full()) return;
+		workerGuiQueue.push(std::make_tuple(mw, json_incref(vJ)));
+		workerGuiPending = true;
+	}
+
+	/** Returns the ids of the bound modules which are (or are not) bound to the GUI thread, called with the slots locked */
+	std::vector<int> boundModuleIds(bool guiThread) {
+		std::vector<int> moduleIds;
+		for (BoundModule* b : boundModules) {
+			if (b->needsGuiThread == guiThread) moduleIds.push_back(b->moduleId);
 		}
+		return moduleIds;
 	}
 
-	void presetSave(int p) {
-		EightFaceMk2Slot* slot = expSlot(p);
-		if (*(slot->presetSlotUsed)) {
-			for (json_t* vJ : *(slot->preset)) {
+	/** Adds durations measured without the slots locked to the bound modules, called with the slots locked */
+	void latencyAdd(std::vector<std::tuple<int, float>>& latency, bool load) {
+		for (std::tuple<int, float>& l : latency) {
+			BoundModule* b = getBoundModule(std::get<0>(l));
+			if (!b) continue;
+			if (load) b->latencyLoad.add(std::get<1>(l));
+			else b->latencySave.add(std::get<1>(l));
+		}
+	}
+
+	/**
+	 * Stores the captured states of the modules not bound to the GUI thread into their slot, called with the slots locked.
+	 * If modules bound to the GUI thread are present the capture is finished and stored by processGui().
+	 */
+	void presetCapture(PendingCapture& c) {
+		EightFaceMk2Slot* slot = expSlot(c.p);
+		if (slot && boundModuleIds(true).empty()) {
+			presetPublish(slot, c.version, c.states);
+		}
+		else if (slot && !workerCaptureQueue.full()) {
+			workerCaptureQueue.push(new PendingCapture(std::move(c)));
+			workerGuiPending = true;
+		}
+		else {
+			for (json_t* vJ : c.states) {
 				json_decref(vJ);
 			}
-			slot->preset->clear();
 		}
+	}
+
+	/** Returns the current states of modules, called without the slots locked */
+	std::vector<json_t*> presetCaptureStates(const std::vector<int>& moduleIds, std::vector<std::tuple<int, float>>& latency) {
+		std::vector<json_t*> states;
+		for (int moduleId : moduleIds) {
+			ModuleWidget* mw = APP->scene->rack->getModule(moduleId);
+			if (!mw) continue;
+			auto t = std::chrono::steady_clock::now();
+			states.push_back(mw->toJson());
+			latency.push_back(std::make_tuple(moduleId, EightFace::LatencyHistogram::since(t)));
+		}
+		return states;
+	}
 
+	/** Replaces the contents of a slot by the captured states, unless the slot changed since the capture started */
+	void presetPublish(EightFaceMk2Slot* slot, uint32_t version, std::vector<json_t*>& states) {
+		if (slot->version != version) {
+			for (json_t* vJ : states) {
+				json_decref(vJ);
+			}
+			return;
+		}
+		for (json_t*& vJ : states) {
+			vJ = presetDedupe(vJ);
+		}
+		for (json_t* vJ : *(slot->preset)) {
+			json_decref(vJ);
+		}
+		slot->preset->swap(states);
 		*(slot->presetSlotUsed) = true;
-		for (BoundModule* b : boundModules) {
-			ModuleWidget* mw = b->getModuleWidget();
+		presetCompile(slot);
+	}
+
+	/**
+	 * Slots never modify stored module states, so identical states are shared between slots
+	 * by reference. Returns the already stored state if an identical one exists.
+	 */
+	json_t* presetDedupe(json_t* vJ) {
+		json_int_t moduleId = json_integer_value(json_object_get(vJ, "id"));
+		for (int i = 0; i < presetTotal; i++) {
+			EightFaceMk2Slot* slot = expSlot(i);
+			for (json_t* sJ : *slot->preset) {
+				if (json_integer_value(json_object_get(sJ, "id")) != moduleId) continue;
+				if (!json_equal(sJ, vJ)) continue;
+				json_incref(sJ);
+				json_decref(vJ);
+				return sJ;
+			}
+		}
+		return vJ;
+	}
+
+	/**
+	 * Resolves the bound modules of a slot and collects their parameter values into flat arrays,
+	 * called with the slots locked.
+	 */
+	void presetCompile(EightFaceMk2Slot* slot) {
+		EightFaceMk2Plan* plan = slot->plan;
+		plan->items.clear();
+		for (json_t* vJ : *slot->preset) {
+			json_t* idJ = json_object_get(vJ, "id");
+			if (!idJ) continue;
+			int moduleId = json_integer_value(idJ);
+			std::string plugin = json_string_value(json_object_get(vJ, "plugin"));
+			std::string model = json_string_value(json_object_get(vJ, "model"));
+			for (BoundModule* b : boundModules) {
+				if (b->moduleId != moduleId) continue;
+				if (b->pluginSlug != plugin || b->modelSlug != model) break;
+
+				EightFaceMk2PlanItem item;
+				item.moduleId = moduleId;
+				item.needsGuiThread = b->needsGuiThread;
+				item.moduleJ = vJ;
+
+				item.params.decode(vJ);
+				json_t* bypassJ = json_object_get(vJ, "bypass");
+				item.bypass = bypassJ && json_boolean_value(bypassJ);
+				json_t* dataJ = json_object_get(vJ, "data");
+				item.hasData = dataJ != NULL;
+				item.dataHash = EightFace::presetDataHash(dataJ);
+				plan->items.push_back(item);
+				break;
+			}
+		}
+		plan->valid = true;
+	}
+
+	/** Returns true if writing the parameter values restores the stored state of a module */
+	bool presetParamsOnly(EightFaceMk2PlanItem& item, Module* m) {
+		if (item.bypass != m->bypass) return false;
+		if (!item.hasData) return true;
+		json_t* dataJ = m->dataToJson();
+		bool paramsOnly = EightFace::presetDataHash(dataJ) == item.dataHash;
+		if (dataJ) json_decref(dataJ);
+		return paramsOnly;
+	}
+
+	/**
+	 * Writes the parameter values of compiled module states, the full JSON is only loaded if the module's data differs.
+	 * dataToJson() is only called for modules which stored data in the snapshot. Called without the slots locked.
+	 */
+	void presetApply(std::vector<PendingLoad>& loads, std::vector<std::tuple<int, float>>& latency) {
+		for (PendingLoad& l : loads) {
+			EightFaceMk2PlanItem& item = l.item;
+			ModuleWidget* mw = APP->scene->rack->getModule(item.moduleId);
 			if (!mw) continue;
-			json_t* vJ = mw->toJson();
-			slot->preset->push_back(vJ);
+			Module* m = mw->module;
+			if (!m) continue;
+
+			auto t = std::chrono::steady_clock::now();
+			if (l.compiled && presetParamsOnly(item, m)) {
+				item.params.apply(m);
+			}
+			else {
+				mw->fromJson(item.moduleJ);
+			}
+			latency.push_back(std::make_tuple(item.moduleId, EightFace::LatencyHistogram::since(t)));
+		}
+	}
+
+	BoundModule* getBoundModule(int moduleId) {
+		for (BoundModule* b : boundModules) {
+			if (b->moduleId == moduleId) return b;
+		}
+		return NULL;
+	}
+
+	json_t* latencyToJson() {
+		json_t* rootJ = json_object();
+		json_object_set_new(rootJ, "guiQueue", latencyGui.toJson());
+		json_t* modulesJ = json_array();
+		for (BoundModule* b : boundModules) {
+			json_t* moduleJ = json_object();
+			json_object_set_new(moduleJ, "moduleId", json_integer(b->moduleId));
+			json_object_set_new(moduleJ, "moduleName", json_string(b->moduleName.c_str()));
+			json_object_set_new(moduleJ, "save", b->latencySave.toJson());
+			json_object_set_new(moduleJ, "load", b->latencyLoad.toJson());
+			json_array_append_new(modulesJ, moduleJ);
+		}
+		json_object_set_new(rootJ, "modules", modulesJ);
+		return rootJ;
+	}
+
+	void latencyReset() {
+		latencyGui.reset();
+		for (BoundModule* b : boundModules) {
+			b->latencySave.reset();
+			b->latencyLoad.reset();
+		}
+	}
+
+	void processGui() {
+		if (!workerGuiPending) return;
+		std::vector<PendingCapture*> captures;
+		std::vector<std::tuple<ModuleWidget*, json_t*>> loads;
+		std::vector<int> moduleIds;
+		{
+			auto locks = slotLock();
+			workerGuiPending = false;
+			while (!workerCaptureQueue.empty()) {
+				captures.push_back(workerCaptureQueue.shift());
+			}
+			while (!workerGuiQueue.empty()) {
+				loads.push_back(workerGuiQueue.shift());
+			}
+			moduleIds = boundModuleIds(true);
+		}
+
+		// Bound modules are called without the slots locked, see processWorker()
+		std::vector<std::tuple<int, float>> latencySave;
+		for (PendingCapture* c : captures) {
+			std::vector<json_t*> states = presetCaptureStates(moduleIds, latencySave);
+			c->states.insert(c->states.end(), states.begin(), states.end());
+		}
+
+		if (!loads.empty()) {
+			auto t0 = std::chrono::steady_clock::now();
+			for (std::tuple<ModuleWidget*, json_t*>& t : loads) {
+				std::get<0>(t)->fromJson(std::get<1>(t));
+			}
+			latencyGui.add(t0);
+		}
+
+		auto locks = slotLock();
+		for (std::tuple<ModuleWidget*, json_t*>& t : loads) {
+			json_decref(std::get<1>(t));
+		}
+		latencyAdd(latencySave, false);
+		for (PendingCapture* c : captures) {
+			EightFaceMk2Slot* slot = expSlot(c->p);
+			if (slot) {
+				presetPublish(slot, c->version, c->states);
+			}
+			else {
+				for (json_t* vJ : c->states) {
+					json_decref(vJ);
+				}
+			}
+			delete c;
 		}
-		preset = p;
 	}
 
+	/** Called with the slots locked */
 	void presetClear(int p) {
 		EightFaceMk2Slot* slot = expSlot(p);
+		slot->version++;
 		if (*(slot->presetSlotUsed)) {
 			for (json_t* vJ : *(slot->preset)) {
 				json_decref(vJ);
@@ -557,6 +959,7 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 			*expSlotLabel(p) = "";
 		}
 		*(slot->presetSlotUsed) = false;
+		slot->plan->clear();
 		if (preset == p) preset = -1;
 	}
 
@@ -572,14 +975,16 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 			if (!mw) continue;
 			mw->randomizeAction();
 		}
-		presetSave(p);
+		presetRequest(SLOT_CMD::SAVE, p);
 	}
 
+	/** Called with the slots locked */
 	void presetCopyPaste(int source, int target) {
 		EightFaceMk2Slot* sourceSlot = expSlot(source);
 		if (!*(sourceSlot->presetSlotUsed)) return;
 
 		EightFaceMk2Slot* targetSlot = expSlot(target);
+		targetSlot->version++;
 		if (*(targetSlot->presetSlotUsed)) {
 			for (json_t* vJ : *(targetSlot->preset)) {
 				json_decref(vJ);
@@ -590,12 +995,15 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 		*(targetSlot->presetSlotUsed) = true;
 		auto sourcePreset = sourceSlot->preset;
 		auto targetPreset = targetSlot->preset;
+		// Module states are shared, not copied
 		for (json_t* vJ : *sourcePreset) {
-			targetPreset->push_back(json_deep_copy(vJ));
+			targetPreset->push_back(json_incref(vJ));
 		}
+		*(targetSlot->plan) = *(sourceSlot->plan);
 		if (preset == target) preset = -1;
 	}
 
+	/** Called with the slots locked */
 	void presetShiftBack(int p) {
 		for (int i = presetTotal - 2; i >= p; i--) {
 			EightFaceMk2Slot* slot = expSlot(i);
@@ -610,6 +1018,7 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 		presetClear(p);
 	}
 
+	/** Called with the slots locked */
 	void presetShiftFront(int p) {
 		for (int i = 1; i <= p; i++) {
 			EightFaceMk2Slot* slot = expSlot(i);
@@ -633,9 +1042,11 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 			case SLOT_CMD::LOAD:
 				presetLoad(i); 
 				return -1;
-			case SLOT_CMD::CLEAR:
+			case SLOT_CMD::CLEAR: {
+				auto locks = slotLock();
 				presetClear(i);
 				return -1;
+			}
 			case SLOT_CMD::RANDOMIZE:
 				presetRandomize(i);
 				return -1;
@@ -644,18 +1055,24 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 				return -1;
 			case SLOT_CMD::PASTE_PREVIEW:
 				return presetCopy;
-			case SLOT_CMD::PASTE:
+			case SLOT_CMD::PASTE: {
+				auto locks = slotLock();
 				presetCopyPaste(presetCopy, i);
 				return -1;
+			}
 			case SLOT_CMD::SAVE:
-				presetSave(i);
+				presetRequest(SLOT_CMD::SAVE, i);
 				return -1;
-			case SLOT_CMD::SHIFT_BACK:
+			case SLOT_CMD::SHIFT_BACK: {
+				auto locks = slotLock();
 				presetShiftBack(i);
 				return -1;
-			case SLOT_CMD::SHIFT_FRONT:
+			}
+			case SLOT_CMD::SHIFT_FRONT: {
+				auto locks = slotLock();
 				presetShiftFront(i);
 				return -1;
+			}
 			default:
 				return -1;
 		}
@@ -672,6 +1089,8 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 		json_object_set_new(rootJ, "preset", json_integer(preset));
 		json_object_set_new(rootJ, "presetCount", json_integer(presetCount));
 
+		json_object_set_new(rootJ, "fastSwitch", json_boolean(fastSwitch));
+		json_object_set_new(rootJ, "prewarm", json_boolean(prewarm));
 		json_object_set_new(rootJ, "boxDraw", json_boolean(boxDraw));
 		json_object_set_new(rootJ, "boxColor", json_string(color::toHexString(boxColor).c_str()));
 
@@ -696,6 +1115,8 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 		preset = json_integer_value(json_object_get(rootJ, "preset"));
 		presetCount = json_integer_value(json_object_get(rootJ, "presetCount"));
 
+		fastSwitch = json_boolean_value(json_object_get(rootJ, "fastSwitch"));
+		prewarm = json_boolean_value(json_object_get(rootJ, "prewarm"));
 		boxDraw = json_boolean_value(json_object_get(rootJ, "boxDraw"));
 		json_t* boxColorJ = json_object_get(rootJ, "boxColor");
 		if (boxColorJ) boxColor = color::fromHexString(json_string_value(boxColorJ));
@@ -708,6 +1129,7 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 		if (APP->engine->getModule(BASE::id) != NULL && !BASE::idFixHasMap()) return;
 
 		inChange = true;
+		std::unique_lock<std::mutex> lock(BASE::slotMutex);
 		for (BoundModule* b : boundModules) {
 			delete b;
 		}
@@ -738,6 +1160,7 @@ struct EightFaceMk2Module : EightFaceMk2Base<NUM_PRESETS> {
 				boundModules.push_back(b);
 			}
 		}
+		lock.unlock();
 		inChange = false;
 
 		BASE::idFixClearMap();
@@ -1045,6 +1468,76 @@ struct EightFaceMk2Widget : ThemedModuleWidget<EightFaceMk2Module<NUM_PRESETS>>
 			}
 		};
 
+		struct FastSwitchItem : MenuItem {
+			MODULE* module;
+			void onAction(const event::Action& e) override {
+				module->fastSwitch ^= true;
+			}
+			void step() override {
+				rightText = CHECKMARK(module->fastSwitch);
+				MenuItem::step();
+			}
+		};
+
+		struct PrewarmItem : MenuItem {
+			MODULE* module;
+			void onAction(const event::Action& e) override {
+				module->prewarm ^= true;
+			}
+			void step() override {
+				rightText = CHECKMARK(module->prewarm);
+				disabled = !module->fastSwitch;
+				MenuItem::step();
+			}
+		};
+
+		struct LatencyMenuItem : MenuItem {
+			struct ModuleItem : MenuItem {
+				typename MODULE::BoundModule* b;
+				ModuleItem() {
+					rightText = RIGHT_ARROW;
+				}
+				Menu* createChildMenu() override {
+					Menu* menu = new Menu;
+					menu->addChild(construct<EightFace::LatencyHistogramItem>(&MenuItem::text, "Save", &EightFace::LatencyHistogramItem::histogram, &b->latencySave));
+					menu->addChild(construct<EightFace::LatencyHistogramItem>(&MenuItem::text, "Load", &EightFace::LatencyHistogramItem::histogram, &b->latencyLoad));
+					return menu;
+				}
+			};
+
+			struct CopyItem : MenuItem {
+				MODULE* module;
+				void onAction(const event::Action& e) override {
+					EightFace::latencyCopyClipboard(module->latencyToJson());
+				}
+			};
+
+			struct ResetItem : MenuItem {
+				MODULE* module;
+				void onAction(const event::Action& e) override {
+					module->latencyReset();
+				}
+			};
+
+			MODULE* module;
+			LatencyMenuItem() {
+				rightText = RIGHT_ARROW;
+			}
+
+			Menu* createChildMenu() override {
+				Menu* menu = new Menu;
+				menu->addChild(construct<EightFace::LatencyHistogramItem>(&MenuItem::text, "GUI queue", &EightFace::LatencyHistogramItem::histogram, &module->latencyGui));
+				menu->addChild(new MenuSeparator);
+				for (typename MODULE::BoundModule* b : module->boundModules) {
+					menu->addChild(construct<ModuleItem>(&MenuItem::text, b->moduleName, &ModuleItem::b, b));
+				}
+				menu->addChild(new MenuSeparator);
+				menu->addChild(construct<CopyItem>(&MenuItem::text, "Copy as JSON", &CopyItem::module, module));
+				menu->addChild(construct<ResetItem>(&MenuItem::text, "Reset", &ResetItem::module, module));
+				return menu;
+			}
+		};
+
 		struct BoxDrawItem : MenuItem {
 			MODULE* module;
 			std::string rightTextEx;
@@ -1084,6 +1577,9 @@ struct EightFaceMk2Widget : ThemedModuleWidget<EightFaceMk2Module<NUM_PRESETS>>
 		menu->addChild(new MenuSeparator());
 		menu->addChild(construct<SlotCvModeMenuItem>(&MenuItem::text, "Port CV mode", &SlotCvModeMenuItem::module, module));
 		//menu->addChild(construct<AutoloadMenuItem>(&MenuItem::text, "Autoload", &AutoloadMenuItem::module, module));
+		menu->addChild(construct<FastSwitchItem>(&MenuItem::text, "Fast switching", &FastSwitchItem::module, module));
+		menu->addChild(construct<PrewarmItem>(&MenuItem::text, "Pre-warm armed snapshot", &PrewarmItem::module, module));
+		menu->addChild(construct<LatencyMenuItem>(&MenuItem::text, "Switching latency", &LatencyMenuItem::module, module));
 		menu->addChild(new MenuSeparator());
 		menu->addChild(construct<BindModuleItem>(&MenuItem::text, "Bind module (left)", &BindModuleItem::widget, this, &BindModuleItem::module, module));
 		menu->addChild(construct<BindModuleSelectItem>(&MenuItem::text, "Bind module (select)", &BindModuleSelectItem::widget, this));
@@ -2,6 +2,8 @@
 #include "plugin.hpp"
 #include "digital.hpp"
 #include "StripIdFixModule.hpp"
+#include "EightFace.hpp"
+#include <mutex>
 
 namespace StoermelderPackOne {
 namespace EightFaceMk2 {
@@ -23,12 +25,38 @@ enum class CTRLMODE {
 	WRITE
 };
 
+/** Snapshot of a single bound module, compiled for applying without parsing JSON */
+struct EightFaceMk2PlanItem {
+	int moduleId;
+	bool needsGuiThread;
+	/** Full module JSON of the snapshot, owned by the slot */
+	json_t* moduleJ;
+	EightFace::PresetParams params;
+	bool bypass;
+	/** Set if the stored state contains module data, otherwise only the parameters are written */
+	bool hasData;
+	size_t dataHash;
+};
+
+struct EightFaceMk2Plan {
+	bool valid = false;
+	std::vector<EightFaceMk2PlanItem> items;
+
+	void clear() {
+		valid = false;
+		items.clear();
+	}
+};
+
 struct EightFaceMk2Slot {
 	Param* param;
 	Light* lights;
 	bool* presetSlotUsed;
 	std::vector<json_t*>* preset;
+	EightFaceMk2Plan* plan;
 	LongPressButton* presetButton;
+	/** Incremented on every change of the slot, captures started on an older version are discarded */
+	uint32_t version = 0;
 };
 
 template <int NUM_PRESETS>
@@ -42,8 +70,12 @@ struct EightFaceMk2Base : Module, StripIdFixModule {
 	std::vector<json_t*> preset[NUM_PRESETS];
 	/** [Stored to JSON] */
 	std::string textLabel[NUM_PRESETS];
+	/** Compiled snapshots, built on demand */
+	EightFaceMk2Plan plan[NUM_PRESETS];
 
 	LongPressButton presetButton[NUM_PRESETS];
+	/** Guards preset and plan of the slots, they are changed by the worker and the GUI thread of the controlling module */
+	std::mutex slotMutex;
 
 	int ctrlModuleId = -1;
 	int ctrlOffset = 0;
@@ -57,7 +89,21 @@ struct EightFaceMk2Base : Module, StripIdFixModule {
 	virtual int faceSlotCmd(SLOT_CMD cmd, int i) { return -1; }
 
 
+	/**
+	 * Stored module states are never modified, so they can be shared between slots.
+	 * Returns a new reference to an identical state of the slots before n, or to vJ itself.
+	 */
+	json_t* presetShare(json_t* vJ, int n) {
+		for (int i = 0; i < n; i++) {
+			for (json_t* sJ : preset[i]) {
+				if (json_equal(sJ, vJ)) return json_incref(sJ);
+			}
+		}
+		return json_incref(vJ);
+	}
+
 	json_t* dataToJson() override {
+		std::lock_guard<std::mutex> lock(slotMutex);
 		json_t* rootJ = json_object();
 		json_object_set_new(rootJ, "panelTheme", json_integer(EightFaceMk2Base<NUM_PRESETS>::panelTheme));
 
@@ -71,7 +117,7 @@ struct EightFaceMk2Base : Module, StripIdFixModule {
 				for (size_t j = 0; j < EightFaceMk2Base<NUM_PRESETS>::preset[i].size(); j++) {
 					json_array_append(slotJ, EightFaceMk2Base<NUM_PRESETS>::preset[i][j]);
 				}
-				json_object_set(presetJ, "slot", slotJ);
+				json_object_set_new(presetJ, "slot", slotJ);
 			}
 			json_array_append_new(presetsJ, presetJ);
 		}
@@ -81,6 +127,7 @@ struct EightFaceMk2Base : Module, StripIdFixModule {
 	}
 
 	void dataFromJson(json_t* rootJ) override {
+		std::lock_guard<std::mutex> lock(slotMutex);
 		panelTheme = json_integer_value(json_object_get(rootJ, "panelTheme"));
 
 		json_t* presetsJ = json_object_get(rootJ, "presets");
@@ -90,13 +137,18 @@ struct EightFaceMk2Base : Module, StripIdFixModule {
 			presetSlotUsed[presetIndex] = json_boolean_value(json_object_get(presetJ, "slotUsed"));
 			json_t* textLabelJ = json_object_get(presetJ, "textLabel");
 			if (textLabelJ) textLabel[presetIndex] = json_string_value(textLabelJ);
+			plan[presetIndex].clear();
+			slot[presetIndex].version++;
+			for (json_t* vJ : preset[presetIndex]) {
+				json_decref(vJ);
+			}
 			preset[presetIndex].clear();
 			if (presetSlotUsed[presetIndex]) {
 				json_t* slotJ = json_object_get(presetJ, "slot");
 				json_t* vJ;
 				size_t j;
 				json_array_foreach(slotJ, j, vJ) {
-					preset[presetIndex].push_back(json_deep_copy(vJ));
+					preset[presetIndex].push_back(presetShare(vJ, presetIndex));
 				}
 			}
 		}
@@ -39,6 +39,7 @@ struct EightFaceMk2ExModule : EightFaceMk2Base<NUM_PRESETS> {
 			BASE::slot[i].lights = &Module::lights[LIGHT_PRESET + i * 3];
 			BASE::slot[i].presetSlotUsed = &BASE::presetSlotUsed[i];
 			BASE::slot[i].preset = &BASE::preset[i];
+			BASE::slot[i].plan = &BASE::plan[i];
 			BASE::slot[i].presetButton = &BASE::presetButton[i];
 		}
 
@@ -56,6 +57,7 @@ struct EightFaceMk2ExModule : EightFaceMk2Base<NUM_PRESETS> {
 	}
 
 	void onReset() override { 
+		std::lock_guard<std::mutex> lock(BASE::slotMutex);
 		for (int i = 0; i < NUM_PRESETS; i++) {
 			if (BASE::presetSlotUsed[i]) {
 				for (json_t* vJ : BASE::preset[i]) {
@@ -66,6 +68,8 @@ struct EightFaceMk2ExModule : EightFaceMk2Base<NUM_PRESETS> {
 			BASE::presetSlotUsed[i] = false;
 			BASE::textLabel[i] = "";
 			BASE::preset[i].clear();
+			BASE::plan[i].clear();
+			BASE::slot[i].version++;
 			BASE::lights[LIGHT_PRESET + (i * 3) + 0].setBrightness(0.f);
 			BASE::lights[LIGHT_PRESET + (i * 3) + 1].setBrightness(0.f);
 			BASE::lights[LIGHT_PRESET + (i * 3) + 2].setBrightness(0.f);
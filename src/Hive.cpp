@@ -27,7 +27,6 @@
 #include "plugin.hpp"
 #include "digital.hpp"
 #include "HiveGrid.hpp"
-#include <random>
 
 namespace StoermelderPackOne {
 namespace Hive {
@@ -78,6 +77,8 @@ const int MAX_RADIUS = 16;				/// Max 16 ensures the area of a cell does not shr
 										/// Max radius > 160 crashes Rack...
 const int MIN_RADIUS = 1;				///
 
+const int MAX_CURSORS = 16;				/// Number of cursors available in polyphonic mode
+
 const float BOX_WIDTH = 262.563f;								/// Grid widget's dimensions in pixels
 const float BOX_HEIGHT = 227.f;									///
 const Vec ORIGIN = Vec(BOX_WIDTH / 2.f, BOX_HEIGHT / 2.f);		/// Hex grid origin is at the center of the widget
@@ -90,16 +91,19 @@ struct HiveCell : HexCell {
 	HiveCell() : state(GRIDSTATE::OFF), cv(0.f) {}
 };
 
-struct HiveCursor : HexCell {
-	DIRECTION startDir;
-	DIRECTION dir;
-	RoundAxialVec startPos;
-	RoundAxialVec pos;
-	TURNMODE turnMode;
-	TURNMODE ninetyState;				/// Used for alternating turns in 90 degree turnmode
-	OUTMODE outMode;
-	RATCHETMODE ratchetingEnabled;
-	float ratchetingProb;
+/** State of all cursors, one array for each property so all cursors can be stepped in one loop */
+template < int NUM_CURSORS >
+struct HiveCursors {
+	DIRECTION startDir[NUM_CURSORS];
+	DIRECTION dir[NUM_CURSORS];
+	RoundAxialVec startPos[NUM_CURSORS];
+	RoundAxialVec pos[NUM_CURSORS];
+	bool diagonalState[NUM_CURSORS] = {};
+	TURNMODE turnMode[NUM_CURSORS];
+	TURNMODE ninetyState[NUM_CURSORS];		/// Used for alternating turns in 90 degree turnmode
+	OUTMODE outMode[NUM_CURSORS];
+	RATCHETMODE ratchetingEnabled[NUM_CURSORS];
+	float ratchetingProb[NUM_CURSORS];
 };
 
 template < int RADIUS, int NUM_PORTS >
@@ -131,10 +135,11 @@ struct HiveModule : Module {
 
 	const int numPorts = NUM_PORTS;
 
-	std::default_random_engine randGen{(uint16_t)std::chrono::system_clock::now().time_since_epoch().count()};
-	std::geometric_distribution<int>* geoDist[NUM_PORTS] = {};
+	/** [Stored to JSON] seed of the cursors' random generators */
+	uint64_t seed;
+	CursorRandom cursorRandom[MAX_CURSORS];
 	
-	typedef HexGrid <HiveCell, HiveCursor, NUM_PORTS, RADIUS, POINTY> HIVEGRID;
+	typedef HexGrid <HiveCell, HiveCursors<MAX_CURSORS>, RADIUS, POINTY> HIVEGRID;
 
 	/** [Stored to JSON] */
 	int panelTheme = 0;
@@ -150,23 +155,28 @@ struct HiveModule : Module {
 	/** [Stored to JSON] */
 	bool normalizePorts;
 
-	dsp::SchmittTrigger clockTrigger[NUM_PORTS];
+	/** [Stored to JSON] number of cursors on the polyphonic first ports, 0 for one cursor on each port */
+	int polyCursors = 0;
+	/** number of cursors running */
+	int numCursors = NUM_PORTS;
+
+	dsp::SchmittTrigger clockTrigger[MAX_CURSORS];
 	bool clockTrigger0;
-	dsp::SchmittTrigger resetTrigger[NUM_PORTS];
+	dsp::SchmittTrigger resetTrigger[MAX_CURSORS];
 	bool resetTrigger0;
-	dsp::SchmittTrigger turnTrigger[NUM_PORTS];
+	dsp::SchmittTrigger turnTrigger[MAX_CURSORS];
 	bool turnTrigger0;
-	dsp::Timer resetTimer[NUM_PORTS];
+	dsp::Timer resetTimer[MAX_CURSORS];
 	float resetTimer0;
-	dsp::PulseGenerator outPulse[NUM_PORTS];
-	ClockMultiplier multiplier[NUM_PORTS];
+	dsp::PulseGenerator outPulse[MAX_CURSORS];
+	ClockMultiplier multiplier[MAX_CURSORS];
 
 	dsp::SchmittTrigger shiftR1Trigger;
 	dsp::SchmittTrigger shiftR2Trigger;
 	dsp::SchmittTrigger shiftL1Trigger;
 	dsp::SchmittTrigger shiftL2Trigger;
 
-	bool active[NUM_PORTS];
+	bool active[MAX_CURSORS];
 	MODULESTATE currentState = MODULESTATE::GRID;
 	bool gridDirty = true;
 
@@ -180,23 +190,18 @@ struct HiveModule : Module {
 		onReset();
 	}
 
-	~HiveModule() {
-		for (int i = 0; i < NUM_PORTS; i++) {
-			delete geoDist[i];
-		}
-	}
-
 	void onReset() override {
 		gridClear();
-		for (int i = 0; i < NUM_PORTS; i++) {
-			grid.cursor[i].pos.q = grid.cursor[i].startPos.q = -grid.usedRadius;								/// SW edge
-			grid.cursor[i].pos.r = grid.cursor[i].startPos.r = (grid.usedRadius + 1) / NUM_PORTS * i;			/// Divide across SW edge
-			grid.cursor[i].dir = grid.cursor[i].startDir = DIRECTION::NE;
-			grid.cursor[i].turnMode = TURNMODE::SIXTY;															/// Start with small turns 
-            grid.cursor[i].ninetyState = TURNMODE::SIXTY;														/// Turnmode 90 starts with a small turn first
-			grid.cursor[i].outMode = OUTMODE::UNI_3V;
+		setSeed(random::u64());
+		setPolyCursors(0);
+		for (int i = 0; i < MAX_CURSORS; i++) {
+			grid.cursor.pos[i] = grid.cursor.startPos[i] = cursorStartPos(i);
+			grid.cursor.dir[i] = grid.cursor.startDir[i] = cursorStartDir(i);
+			grid.cursor.turnMode[i] = TURNMODE::SIXTY;															/// Start with small turns 
+            grid.cursor.ninetyState[i] = TURNMODE::SIXTY;														/// Turnmode 90 starts with a small turn first
+			grid.cursor.outMode[i] = OUTMODE::UNI_3V;
 			resetTimer[i].reset();
-			grid.cursor[i].ratchetingEnabled = RATCHETMODE::DEFAULT;
+			grid.cursor.ratchetingEnabled[i] = RATCHETMODE::DEFAULT;
 			ratchetingSetProb(i);
 		}
 		normalizePorts = true;
@@ -206,54 +211,62 @@ struct HiveModule : Module {
 
 	void process(const ProcessArgs& args) override {
 		if (shiftR1Trigger.process(inputs[SHIFT_R1_INPUT].getVoltage()))
-			for (int i = 0; i < NUM_PORTS; i++)
-				grid.moveCursor(i, (grid.cursor[i].dir + 2) % 12);
+			for (int i = 0; i < numCursors; i++)
+				grid.moveCursor(i, (grid.cursor.dir[i] + 2) % 12);
 		if (shiftR2Trigger.process(inputs[SHIFT_R2_INPUT].getVoltage()))
-			for (int i = 0; i < NUM_PORTS; i++)
-				grid.moveCursor(i, (grid.cursor[i].dir + 4) % 12);
+			for (int i = 0; i < numCursors; i++)
+				grid.moveCursor(i, (grid.cursor.dir[i] + 4) % 12);
 		if (shiftL1Trigger.process(inputs[SHIFT_L1_INPUT].getVoltage()))
-			for (int i = 0; i < NUM_PORTS; i++)
-				grid.moveCursor(i, (grid.cursor[i].dir + 10) % 12);
+			for (int i = 0; i < numCursors; i++)
+				grid.moveCursor(i, (grid.cursor.dir[i] + 10) % 12);
 		if (shiftL1Trigger.process(inputs[SHIFT_L1_INPUT].getVoltage()))
-			for (int i = 0; i < NUM_PORTS; i++)
-				grid.moveCursor(i, (grid.cursor[i].dir + 8) % 12);
-
-		for (int i = 0; i < NUM_PORTS; i++) {
-			active[i] = outputs[TRIG_OUTPUT + i].isConnected() || outputs[CV_OUTPUT + i].isConnected();
+			for (int i = 0; i < numCursors; i++)
+				grid.moveCursor(i, (grid.cursor.dir[i] + 8) % 12);
+
+		// In poly mode all cursors use the first ports, one channel each
+		bool poly = polyCursors > 0;
+		int channels = poly ? numCursors : 1;
+		outputs[TRIG_OUTPUT].setChannels(channels);
+		outputs[CV_OUTPUT].setChannels(channels);
+
+		for (int i = 0; i < numCursors; i++) {
+			int port = poly ? 0 : i;
+			int c = poly ? i : 0;
+			active[i] = outputs[TRIG_OUTPUT + port].isConnected() || outputs[CV_OUTPUT + port].isConnected();
 			bool doPulse = false;
 
 			if (processResetTrigger(i)) {
-				grid.cursor[i].pos = grid.cursor[i].startPos;
-				grid.cursor[i].dir = grid.cursor[i].startDir;
+				grid.cursor.pos[i] = grid.cursor.startPos[i];
+				grid.cursor.dir[i] = grid.cursor.startDir[i];
 				multiplier[i].reset();
 			}
 
 			if (processClockTrigger(i, args.sampleTime)) {
-				grid.moveCursor(i, grid.cursor[i].dir);
+				grid.moveCursor(i, grid.cursor.dir[i]);
 				multiplier[i].tick();
 
-				switch (grid.getCell(grid.cursor[i].pos).state) {
+				switch (grid.cellAt(grid.cursor.pos[i]).state) {
 					case GRIDSTATE::OFF:
 						break;
 					case GRIDSTATE::ON:
 						doPulse = true;
 						break;
 					case GRIDSTATE::RANDOM:
-						switch (grid.cursor[i].ratchetingEnabled) {
+						switch (grid.cursor.ratchetingEnabled[i]) {
 							case RATCHETMODE::OFF:
-								doPulse = random::uniform() >= 0.5f;
+								doPulse = cursorRandom[i].uniform() >= 0.5f;
 								break;
 							case RATCHETMODE::DEFAULT:
-								if (geoDist[i]) multiplier[i].trigger((*geoDist[i])(randGen));
+								multiplier[i].trigger(cursorRandom[i].geometric());
 								break;
 							case RATCHETMODE::MULT_TWO:
-								if (geoDist[i]) multiplier[i].trigger(2 * ((*geoDist[i])(randGen) + 1));
+								multiplier[i].trigger(2 * (cursorRandom[i].geometric() + 1));
 								break;
 							case RATCHETMODE::MULT_THREE:
-								if (geoDist[i]) multiplier[i].trigger(3 * ((*geoDist[i])(randGen) + 1));
+								multiplier[i].trigger(3 * (cursorRandom[i].geometric() + 1));
 								break;
 							case RATCHETMODE::POWER_TWO:
-								if (geoDist[i]) multiplier[i].trigger(std::pow(2, (*geoDist[i])(randGen)));
+								multiplier[i].trigger(1u << std::min(cursorRandom[i].geometric(), 31));
 								break;
 						}
 						break;
@@ -261,36 +274,36 @@ struct HiveModule : Module {
 			}
 
 			if (processTurnTrigger(i)) {
-				switch (grid.cursor[i].turnMode) {
+				switch (grid.cursor.turnMode[i]) {
 					case TURNMODE::SIXTY:
-						grid.cursor[i].dir = (DIRECTION)((grid.cursor[i].dir + 2) % 12);
+						grid.cursor.dir[i] = (DIRECTION)((grid.cursor.dir[i] + 2) % 12);
 						break;
 					case TURNMODE::NINETY:
-						if (grid.cursor[i].ninetyState == TURNMODE::SIXTY) {
-							grid.cursor[i].dir = (DIRECTION)((grid.cursor[i].dir + 2) % 12);
-							grid.cursor[i].ninetyState = TURNMODE::ONETWENTY;
+						if (grid.cursor.ninetyState[i] == TURNMODE::SIXTY) {
+							grid.cursor.dir[i] = (DIRECTION)((grid.cursor.dir[i] + 2) % 12);
+							grid.cursor.ninetyState[i] = TURNMODE::ONETWENTY;
 						}
 						else {
-							grid.cursor[i].dir = (DIRECTION)((grid.cursor[i].dir + 4) % 12);
-							grid.cursor[i].ninetyState = TURNMODE::SIXTY;
+							grid.cursor.dir[i] = (DIRECTION)((grid.cursor.dir[i] + 4) % 12);
+							grid.cursor.ninetyState[i] = TURNMODE::SIXTY;
 						}
 						break;
 					case TURNMODE::ONETWENTY:
-						grid.cursor[i].dir = (DIRECTION)((grid.cursor[i].dir + 4) % 12);
+						grid.cursor.dir[i] = (DIRECTION)((grid.cursor.dir[i] + 4) % 12);
 						break;
 					case TURNMODE::ONEEIGHTY:
-						grid.cursor[i].dir = (DIRECTION)((grid.cursor[i].dir + 6) % 12);
+						grid.cursor.dir[i] = (DIRECTION)((grid.cursor.dir[i] + 6) % 12);
 						break;
 				}
 			}
 
 			float outGate = 0.f;
-			float outCv = outputs[CV_OUTPUT + i].getVoltage();
+			float outCv = outputs[CV_OUTPUT + port].getVoltage(c);
 
 			if (multiplier[i].process() || doPulse) {
 				outPulse[i].trigger();
-				HiveCell cell = grid.getCell(grid.cursor[i].pos);
-				switch (grid.cursor[i].outMode) {
+				HiveCell& cell = grid.cellAt(grid.cursor.pos[i]);
+				switch (grid.cursor.outMode[i]) {
 					case OUTMODE::BI_5V:
 						outCv = rescale(cell.cv, 0.f, 1.f, -5.f, 5.f);
 						break;
@@ -309,18 +322,35 @@ struct HiveModule : Module {
 			if (outPulse[i].process(args.sampleTime))
 				outGate = 10.f;
 
-			outputs[TRIG_OUTPUT + i].setVoltage(outGate);
-			outputs[CV_OUTPUT + i].setVoltage(outCv);
+			outputs[TRIG_OUTPUT + port].setVoltage(outGate, c);
+			outputs[CV_OUTPUT + port].setVoltage(outCv, c);
+		}
+
+		if (poly) {
+			for (int i = 1; i < NUM_PORTS; i++) {
+				outputs[TRIG_OUTPUT + i].setVoltage(0.f);
+				outputs[CV_OUTPUT + i].setVoltage(0.f);
+			}
 		}
 
 		// Set channel lights infrequently
 		if (lightDivider.process()) {
 			float s = args.sampleTime * lightDivider.division;
 			for (int i = 0; i < NUM_PORTS; i++) {
-				float l = outputs[TRIG_OUTPUT + i].isConnected() && outputs[TRIG_OUTPUT + i].getVoltage() > 0.f;
+				// Polyphonic outputs light up for the channel with the highest voltage
+				float l = 0.f;
+				for (int c = 0; c < outputs[TRIG_OUTPUT + i].getChannels(); c++) {
+					l = std::max(l, outputs[TRIG_OUTPUT + i].getVoltage(c));
+				}
+				l = outputs[TRIG_OUTPUT + i].isConnected() && l > 0.f;
 				lights[TRIG_LIGHT + i].setSmoothBrightness(l, s);
 
-				float l1 = outputs[CV_OUTPUT + i].getVoltage() * outputs[CV_OUTPUT + i].isConnected();
+				float l1 = 0.f;
+				for (int c = 0; c < outputs[CV_OUTPUT + i].getChannels(); c++) {
+					float v = outputs[CV_OUTPUT + i].getVoltage(c);
+					if (std::abs(v) > std::abs(l1)) l1 = v;
+				}
+				l1 *= outputs[CV_OUTPUT + i].isConnected();
 				float l2 = l1;
 				if (l1 > 0.f) l1 = rescale(l1, 0.f, 5.f, 0.f, 1.f);
 				lights[CV_LIGHT + i * 2].setSmoothBrightness(l1, s);
@@ -331,6 +361,11 @@ struct HiveModule : Module {
 	}
 
 	inline bool processResetTrigger(int port) {
+		if (polyCursors > 0) {
+			bool r = resetTrigger[port].process(inputs[RESET_INPUT].getPolyVoltage(port) + params[RESET_PARAM].getValue());
+			if (r) resetTimer[port].reset();
+			return r;
+		}
 		if (port == 0) {
 			resetTrigger0 = resetTrigger[0].process(inputs[RESET_INPUT].getVoltage() + params[RESET_PARAM].getValue());
 			if (resetTrigger0) resetTimer[0].reset();
@@ -349,6 +384,10 @@ struct HiveModule : Module {
 	}
 
 	inline bool processClockTrigger(int port, float sampleTime) {
+		if (polyCursors > 0) {
+			bool r = resetTimer[port].process(sampleTime) >= 1e-3f;
+			return r && clockTrigger[port].process(inputs[CLK_INPUT].getPolyVoltage(port));
+		}
 		if (port == 0) {
 			resetTimer0 = resetTimer[0].process(sampleTime);
 			clockTrigger0 = resetTimer0 >= 1e-3f && clockTrigger[0].process(inputs[CLK_INPUT].getVoltage());
@@ -369,6 +408,9 @@ struct HiveModule : Module {
 	}
 
 	inline bool processTurnTrigger(int port) {
+		if (polyCursors > 0) {
+			return turnTrigger[port].process(inputs[TURN_INPUT].getPolyVoltage(port));
+		}
 		if (port == 0) {
 			turnTrigger0 = turnTrigger[0].process(inputs[TURN_INPUT].getVoltage());
 			return turnTrigger0;
@@ -383,6 +425,26 @@ struct HiveModule : Module {
 		}
 	}
 
+	/** Start positions are divided across the SW edge, every further group of NUM_PORTS cursors uses the next edge clockwise */
+	RoundAxialVec cursorStartPos(int i) {
+		RoundAxialVec pos = RoundAxialVec(-grid.usedRadius, (grid.usedRadius + 1) / NUM_PORTS * (i % NUM_PORTS));
+		for (int k = 0; k < i / NUM_PORTS; k++) {
+			pos = RoundAxialVec(-pos.r, pos.q + pos.r);											/// Rotate 60 degrees clockwise
+		}
+		return pos;
+	}
+
+	/** Start directions are rotated along with the start positions */
+	DIRECTION cursorStartDir(int i) {
+		return (DIRECTION)((DIRECTION::NE + 2 * (i / NUM_PORTS)) % 12);
+	}
+
+	void setPolyCursors(int n) {
+		polyCursors = clamp(n, 0, MAX_CURSORS);
+		numCursors = polyCursors > 0 ? polyCursors : NUM_PORTS;
+		gridDirty = true;
+	}
+
 	void gridClear() {
 		HiveCell cell = HiveCell(GRIDSTATE::OFF, 0.f);
 		for (int q = -RADIUS; q <= RADIUS; q++) {
@@ -399,11 +461,10 @@ struct HiveModule : Module {
 		sizeFactor = (BOX_HEIGHT / (((2 * radius) * (3.f / 4.f)) + 1)) / 2.f;
 		grid.setRadius(radius);
 
-		for (int i = 0; i < NUM_PORTS; i++) {
-			grid.cursor[i].startPos.q = -grid.usedRadius;								/// SW edge
-			grid.cursor[i].startPos.r = (grid.usedRadius + 1) / NUM_PORTS * i;			/// Divide across SW edge
+		for (int i = 0; i < MAX_CURSORS; i++) {
+			grid.cursor.startPos[i] = cursorStartPos(i);
 
-			if (!cellVisible(grid.cursor[i].pos, radius))
+			if (!cellVisible(grid.cursor.pos[i], radius))
 				grid.wrapCursor(i);
 		}
 		gridDirty = true;
@@ -443,10 +504,49 @@ struct HiveModule : Module {
 	}
 
 	void ratchetingSetProb(int id, float prob = 0.35f) {
-		auto geoDistOld = geoDist[id];
-		geoDist[id] = new std::geometric_distribution<int>(prob);
-		if (geoDistOld) delete geoDistOld;
-		grid.cursor[id].ratchetingProb = prob;
+		cursorRandom[id].setGeometric(prob);
+		grid.cursor.ratchetingProb[id] = prob;
+	}
+
+	void setSeed(uint64_t seed) {
+		this->seed = seed;
+		for (int i = 0; i < MAX_CURSORS; i++) {
+			cursorRandom[i].seed(seed + i);
+		}
+	}
+
+	json_t* cursorToJson(int i) {
+		json_t* portJ = json_object();
+		json_object_set_new(portJ, "qStartPos", json_integer(grid.cursor.startPos[i].q));
+		json_object_set_new(portJ, "rStartPos", json_integer(grid.cursor.startPos[i].r));
+		json_object_set_new(portJ, "startDir", json_integer(grid.cursor.startDir[i]));
+		json_object_set_new(portJ, "qPos", json_integer(grid.cursor.pos[i].q));
+		json_object_set_new(portJ, "rPos", json_integer(grid.cursor.pos[i].r));
+		json_object_set_new(portJ, "dir", json_integer(grid.cursor.dir[i]));
+		json_object_set_new(portJ, "turnMode", json_integer((int)grid.cursor.turnMode[i]));
+		json_object_set_new(portJ, "ninetyState", json_integer((int)grid.cursor.ninetyState[i]));
+		json_object_set_new(portJ, "outMode", json_integer((int)grid.cursor.outMode[i]));
+		json_object_set_new(portJ, "ratchetingProb", json_real(grid.cursor.ratchetingProb[i]));
+		json_object_set_new(portJ, "ratchetingEnabled", json_integer((int)grid.cursor.ratchetingEnabled[i]));
+		return portJ;
+	}
+
+	void cursorFromJson(int i, json_t* portJ) {
+		grid.cursor.startPos[i].q = json_integer_value(json_object_get(portJ, "qStartPos"));
+		grid.cursor.startPos[i].r = json_integer_value(json_object_get(portJ, "rStartPos"));
+		grid.cursor.startDir[i] = (DIRECTION)json_integer_value(json_object_get(portJ, "startDir"));
+		grid.cursor.pos[i].q = json_integer_value(json_object_get(portJ, "qPos"));
+		grid.cursor.pos[i].r = json_integer_value(json_object_get(portJ, "rPos"));
+		grid.cursor.dir[i] = (DIRECTION)json_integer_value(json_object_get(portJ, "dir"));
+		grid.cursor.turnMode[i] = (TURNMODE)json_integer_value(json_object_get(portJ, "turnMode"));
+		grid.cursor.ninetyState[i] = (TURNMODE)json_integer_value(json_object_get(portJ, "ninetyState"));
+		grid.cursor.outMode[i] = (OUTMODE)json_integer_value(json_object_get(portJ, "outMode"));
+		grid.cursor.ratchetingEnabled[i] = (RATCHETMODE)json_integer_value(json_object_get(portJ, "ratchetingEnabled"));
+
+		json_t* ratchetingProbJ = json_object_get(portJ, "ratchetingProb");
+		if (ratchetingProbJ) {
+			ratchetingSetProb(i, json_real_value(ratchetingProbJ));
+		}
 	}
 
 	json_t* dataToJson() override {
@@ -480,28 +580,24 @@ struct HiveModule : Module {
 		}
 		json_object_set_new(rootJ, "mirrorCenters", mirrorsJ);
 
+		// Only the first cursors are stored in "ports" to keep patches loadable in older versions
 		json_t* portsJ = json_array();
 		for (int i = 0; i < NUM_PORTS; i++) {
-			json_t* portJ = json_object();
-			json_object_set_new(portJ, "qStartPos", json_integer(grid.cursor[i].startPos.q));
-			json_object_set_new(portJ, "rStartPos", json_integer(grid.cursor[i].startPos.r));
-			json_object_set_new(portJ, "startDir", json_integer(grid.cursor[i].startDir));
-			json_object_set_new(portJ, "qPos", json_integer(grid.cursor[i].pos.q));
-			json_object_set_new(portJ, "rPos", json_integer(grid.cursor[i].pos.r));
-			json_object_set_new(portJ, "dir", json_integer(grid.cursor[i].dir));
-			json_object_set_new(portJ, "turnMode", json_integer((int)grid.cursor[i].turnMode));
-			json_object_set_new(portJ, "ninetyState", json_integer((int)grid.cursor[i].ninetyState));
-			json_object_set_new(portJ, "outMode", json_integer((int)grid.cursor[i].outMode));
-			json_object_set_new(portJ, "ratchetingProb", json_real(grid.cursor[i].ratchetingProb));
-			json_object_set_new(portJ, "ratchetingEnabled", json_integer((int)grid.cursor[i].ratchetingEnabled));
-			json_array_append_new(portsJ, portJ);
+			json_array_append_new(portsJ, cursorToJson(i));
 		}
 		json_object_set_new(rootJ, "ports", portsJ);
+		json_t* polyPortsJ = json_array();
+		for (int i = NUM_PORTS; i < MAX_CURSORS; i++) {
+			json_array_append_new(polyPortsJ, cursorToJson(i));
+		}
+		json_object_set_new(rootJ, "polyPorts", polyPortsJ);
 
 		json_object_set_new(rootJ, "usedRadius", json_integer(grid.usedRadius));
 		json_object_set_new(rootJ, "sizeFactor", json_real(sizeFactor));
 
 		json_object_set_new(rootJ, "normalizePorts", json_boolean(normalizePorts));
+		json_object_set_new(rootJ, "seed", json_integer((json_int_t)seed));
+		json_object_set_new(rootJ, "polyCursors", json_integer(polyCursors));
 		return rootJ;
 	}
 
@@ -535,34 +631,31 @@ struct HiveModule : Module {
 		json_t* portJ;
 		size_t portIndex;
 		json_array_foreach(portsJ, portIndex, portJ) {
-			grid.cursor[portIndex].startPos.q = json_integer_value(json_object_get(portJ, "qStartPos"));
-			grid.cursor[portIndex].startPos.r = json_integer_value(json_object_get(portJ, "rStartPos"));	
-			grid.cursor[portIndex].startDir = (DIRECTION)json_integer_value(json_object_get(portJ, "startDir"));
-			grid.cursor[portIndex].pos.q = json_integer_value(json_object_get(portJ, "qPos"));
-			grid.cursor[portIndex].pos.r = json_integer_value(json_object_get(portJ, "rPos"));
-			grid.cursor[portIndex].dir = (DIRECTION)json_integer_value(json_object_get(portJ, "dir"));
-			grid.cursor[portIndex].turnMode = (TURNMODE)json_integer_value(json_object_get(portJ, "turnMode"));
-			grid.cursor[portIndex].ninetyState = (TURNMODE)json_integer_value(json_object_get(portJ, "ninetyState"));
-			grid.cursor[portIndex].outMode = (OUTMODE)json_integer_value(json_object_get(portJ, "outMode"));
-			grid.cursor[portIndex].ratchetingEnabled = (RATCHETMODE)json_integer_value(json_object_get(portJ, "ratchetingEnabled"));
-
-			json_t* ratchetingProbJ = json_object_get(portJ, "ratchetingProb");
-			if (ratchetingProbJ) {
-				ratchetingSetProb(portIndex, json_real_value(ratchetingProbJ));
-			}
+			if (portIndex >= (size_t)NUM_PORTS) break;
+			cursorFromJson(portIndex, portJ);
+		}
+
+		json_t* polyPortsJ = json_object_get(rootJ, "polyPorts");
+		json_array_foreach(polyPortsJ, portIndex, portJ) {
+			if (portIndex >= (size_t)(MAX_CURSORS - NUM_PORTS)) break;
+			cursorFromJson(NUM_PORTS + portIndex, portJ);
 		}
 
 		grid.usedRadius = json_integer_value(json_object_get(rootJ, "usedRadius"));
+		grid.updateNeighbours();
 		sizeFactor = json_real_value(json_object_get(rootJ, "sizeFactor"));
 
 		json_t* normalizePortsJ = json_object_get(rootJ, "normalizePorts");
 		if (normalizePortsJ) normalizePorts = json_boolean_value(normalizePortsJ);
+		json_t* seedJ = json_object_get(rootJ, "seed");
+		if (seedJ) setSeed((uint64_t)json_integer_value(seedJ));
+		setPolyCursors(json_integer_value(json_object_get(rootJ, "polyCursors")));
 
 		json_t* ratchetingEnabledJ = json_object_get(rootJ, "ratchetingEnabled");
 		json_t* ratchetingProbJ = json_object_get(rootJ, "ratchetingProb");
 		if (ratchetingEnabledJ) {
-			for (int i = 0; i < NUM_PORTS; i++) {
-				grid.cursor[i].ratchetingEnabled = (RATCHETMODE)json_integer_value(ratchetingEnabledJ);
+			for (int i = 0; i < MAX_CURSORS; i++) {
+				grid.cursor.ratchetingEnabled[i] = (RATCHETMODE)json_integer_value(ratchetingEnabledJ);
 				ratchetingSetProb(i, json_real_value(ratchetingProbJ));
 			}
 		}
@@ -816,31 +909,31 @@ struct HiveDrawHelper {
 		float cursorRadius = (sqrt(3.f) * module->sizeFactor) / 2.f;
 
 		nvgGlobalCompositeOperation(args.vg, NVG_LIGHTER);
-		for (int i = 0; i < module->numPorts; i++) {
+		for (int i = 0; i < module->numCursors; i++) {
 			if (module->currentState == MODULESTATE::EDIT || module->active[i]) {
-				c = hexToPixel(	module->currentState == MODULESTATE::EDIT ? module->grid.cursor[i].startPos : module->grid.cursor[i].pos, 
+				c = hexToPixel(	module->currentState == MODULESTATE::EDIT ? module->grid.cursor.startPos[i] : module->grid.cursor.pos[i], 
 								module->sizeFactor, POINTY, ORIGIN);
 				// Inner circle
 				nvgGlobalCompositeOperation(args.vg, NVG_ATOP);
 				nvgBeginPath(args.vg);
 				nvgCircle(args.vg, c.x, c.y, cursorRadius * 0.75f);
-				nvgFillColor(args.vg, color::mult(colors[i], 0.35f));
+				nvgFillColor(args.vg, color::mult(colors[i % 4], 0.35f));
 				nvgFill(args.vg);
 				// Outer cirlce
 				nvgBeginPath(args.vg);
 				nvgCircle(args.vg, c.x, c.y, cursorRadius - 0.7f);
-				nvgStrokeColor(args.vg, color::mult(colors[i], 0.9f));
+				nvgStrokeColor(args.vg, color::mult(colors[i % 4], 0.9f));
 				nvgStrokeWidth(args.vg, 0.7f);
 				nvgStroke(args.vg);
 			}
 		}
-		for (int i = 0; i < module->numPorts; i++) {
+		for (int i = 0; i < module->numCursors; i++) {
 			if (module->currentState == MODULESTATE::EDIT || module->active[i]) {
-				c = hexToPixel(	module->currentState == MODULESTATE::EDIT ? module->grid.cursor[i].startPos : module->grid.cursor[i].pos, 
+				c = hexToPixel(	module->currentState == MODULESTATE::EDIT ? module->grid.cursor.startPos[i] : module->grid.cursor.pos[i], 
 								module->sizeFactor, POINTY, ORIGIN);
 				// Halo
 				NVGpaint paint;
-				NVGcolor icol = color::mult(colors[i], 0.25f);
+				NVGcolor icol = color::mult(colors[i % 4], 0.25f);
 				NVGcolor ocol = nvgRGB(0, 0, 0);
 				nvgGlobalCompositeOperation(args.vg, NVG_LIGHTER);
 				nvgBeginPath(args.vg);
@@ -892,13 +985,13 @@ struct HiveStartPosEditWidget : LightWidget, HiveDrawHelper<MODULE> {
 			float triangleRadius = (sqrt(3.f) * module->sizeFactor) / 2.f * 0.75f;
 
 			nvgGlobalCompositeOperation(args.vg, NVG_LIGHTER);
-			for (int i = 0; i < module->numPorts; i++) {
+			for (int i = 0; i < module->numCursors; i++) {
 				// Direction triangle
-				Vec c = hexToPixel(module->grid.cursor[i].startPos, module->sizeFactor, POINTY, ORIGIN);	
+				Vec c = hexToPixel(module->grid.cursor.startPos[i], module->sizeFactor, POINTY, ORIGIN);	
 				Vec p1 = Vec(triangleRadius, 0);
 				Vec p2 = Vec(0, -triangleRadius);
 				Vec p3 = Vec(0, triangleRadius);
-				switch (module->grid.cursor[i].startDir) {
+				switch (module->grid.cursor.startDir[i]) {
 					case NE:
 						p1 = c.plus(p1.rotate(M_PI / -3.f));
 						p2 = c.plus(p2.rotate(M_PI / -3.f));
@@ -949,8 +1042,8 @@ struct HiveStartPosEditWidget : LightWidget, HiveDrawHelper<MODULE> {
 				selectedId = -1;
 				if (gridHovered(e.pos, BOX_WIDTH / 2.f, FLAT, ORIGIN)) {
 					RoundAxialVec hex = pixelToHex(e.pos, module->sizeFactor, POINTY, ORIGIN);
-					for (int i = 0; i < module->numPorts; i++) {
-						if (module->grid.cursor[i].startPos.q == hex.q && module->grid.cursor[i].startPos.r == hex.r) {
+					for (int i = 0; i < module->numCursors; i++) {
+						if (module->grid.cursor.startPos[i].q == hex.q && module->grid.cursor.startPos[i].r == hex.r) {
 							selectedId = i;
 							break;
 						}
@@ -983,7 +1076,7 @@ struct HiveStartPosEditWidget : LightWidget, HiveDrawHelper<MODULE> {
 			math::Vec pos = APP->scene->rack->mousePos.minus(dragPos);
 			RoundAxialVec hex = pixelToHex(pos, module->sizeFactor, POINTY, ORIGIN);
 			if (cellVisible(hex.q, hex.r, module->grid.usedRadius)) {
-				module->grid.cursor[selectedId].startPos = hex;
+				module->grid.cursor.startPos[selectedId] = hex;
 			}
 		}
 	}
@@ -997,11 +1090,11 @@ struct HiveStartPosEditWidget : LightWidget, HiveDrawHelper<MODULE> {
 			int id;
 
 			void onAction(const event::Action &e) override {
-				module->grid.cursor[id].startDir = dir;
+				module->grid.cursor.startDir[id] = dir;
 			}
 
 			void step() override {
-				bool s = module->grid.cursor[id].startDir == dir;
+				bool s = module->grid.cursor.startDir[id] == dir;
 				rightText = s ? "✔" : "";
 				MenuItem::step();
 			}
@@ -1021,11 +1114,11 @@ struct HiveStartPosEditWidget : LightWidget, HiveDrawHelper<MODULE> {
 			int id;
 
 			void onAction(const event::Action &e) override {
-				module->grid.cursor[id].turnMode = turnMode;
+				module->grid.cursor.turnMode[id] = turnMode;
 			}
 
 			void step() override {
-				rightText = module->grid.cursor[id].turnMode == turnMode ? "✔" : "";
+				rightText = module->grid.cursor.turnMode[id] == turnMode ? "✔" : "";
 				MenuItem::step();
 			}
 		};
@@ -1043,11 +1136,11 @@ struct HiveStartPosEditWidget : LightWidget, HiveDrawHelper<MODULE> {
 			int id;
 
 			void onAction(const event::Action &e) override {
-				module->grid.cursor[id].outMode = outMode;
+				module->grid.cursor.outMode[id] = outMode;
 			}
 
 			void step() override {
-				rightText = module->grid.cursor[id].outMode == outMode ? "✔" : "";
+				rightText = module->grid.cursor.outMode[id] == outMode ? "✔" : "";
 				MenuItem::step();
 			}
 		};
@@ -1068,10 +1161,10 @@ struct HiveStartPosEditWidget : LightWidget, HiveDrawHelper<MODULE> {
 				int id;
 				RATCHETMODE mode;
 				void onAction(const event::Action& e) override {
-					module->grid.cursor[id].ratchetingEnabled = mode;
+					module->grid.cursor.ratchetingEnabled[id] = mode;
 				}
 				void step() override {
-					rightText = CHECKMARK(module->grid.cursor[id].ratchetingEnabled == mode);
+					rightText = CHECKMARK(module->grid.cursor.ratchetingEnabled[id] == mode);
 					MenuItem::step();
 				}
 			};
@@ -1106,7 +1199,7 @@ struct HiveStartPosEditWidget : LightWidget, HiveDrawHelper<MODULE> {
 				}
 
 				void step() override {
-					rightText = module->grid.cursor[id].ratchetingProb == ratchetingProb ? "✔" : "";
+					rightText = module->grid.cursor.ratchetingProb[id] == ratchetingProb ? "✔" : "";
 					MenuItem::step();
 				}
 			};
@@ -1282,8 +1375,37 @@ struct HiveWidget : ThemedModuleWidget<HiveModule<MAX_RADIUS, 4>> {
 			}
 		};
 
+		struct PolyCursorsMenuItem : MenuItem {
+			MODULE* module;
+			PolyCursorsMenuItem() {
+				rightText = RIGHT_ARROW;
+			}
+
+			struct PolyCursorsItem : MenuItem {
+				MODULE* module;
+				int polyCursors;
+				void onAction(const event::Action& e) override {
+					module->setPolyCursors(polyCursors);
+				}
+				void step() override {
+					rightText = CHECKMARK(module->polyCursors == polyCursors);
+					MenuItem::step();
+				}
+			};
+
+			Menu* createChildMenu() override {
+				Menu* menu = new Menu;
+				menu->addChild(construct<PolyCursorsItem>(&MenuItem::text, "Off", &PolyCursorsItem::module, module, &PolyCursorsItem::polyCursors, 0));
+				for (int i = 1; i <= MAX_CURSORS; i++) {
+					menu->addChild(construct<PolyCursorsItem>(&MenuItem::text, string::f("%i", i), &PolyCursorsItem::module, module, &PolyCursorsItem::polyCursors, i));
+				}
+				return menu;
+			}
+		};
+
 		menu->addChild(new MenuSeparator());
 		menu->addChild(construct<NormalizePortsItem>(&MenuItem::text, "Normalize inputs to Yellow", &NormalizePortsItem::module, module));
+		menu->addChild(construct<PolyCursorsMenuItem>(&MenuItem::text, "Polyphonic cursors", &PolyCursorsMenuItem::module, module));
 	}
 };
 
@@ -34,6 +34,19 @@ enum ROTATION {
 	POINTY = 1
 };
 
+/** Axial offsets of the six neighbours of a cell */
+const int NEIGHBOUR_Q[6] = { 1, 1, 0, -1, -1,  0 };
+const int NEIGHBOUR_R[6] = {-1, 0, 1,  1,  0, -1 };
+
+/**
+ * Neighbour taken for each clock direction, indexed by the diagonal state of the cursor.
+ * Directions pointing between two neighbours alternate, the cursor's diagonal state toggles on these.
+ */
+const int FLAT_STEP[12][2] = {	{5, 5}, {0, 5}, {0, 0}, {1, 0}, {1, 1}, {2, 1},
+								{2, 2}, {3, 2}, {3, 3}, {4, 3}, {4, 4}, {5, 4}};
+const int POINTY_STEP[12][2] = {{0, 5}, {0, 0}, {1, 0}, {1, 1}, {2, 1}, {2, 2},
+								{3, 2}, {3, 3}, {4, 3}, {4, 4}, {5, 4}, {5, 5}};
+
 struct CubeVec {
 	float x = 0.f;
 	float y = 0.f;
@@ -205,13 +218,16 @@ struct HexCell {
 	HexCell() {}
 };
 
-template < class CELL, class CURSOR, int NUM_CURSORS, int MAX_RADIUS, ROTATION CELL_SHAPE >
+template < class CELL, class CURSORS, int MAX_RADIUS, ROTATION CELL_SHAPE >
 struct HexGrid {
 	int usedRadius;
 	const int arraySize = 2 * MAX_RADIUS + 1;
 	CELL cellMap[2 * MAX_RADIUS + 1][2 * MAX_RADIUS + 1];
-	CURSOR cursor[NUM_CURSORS];
+	CURSORS cursor;
 	CubeVec mirrorCenters[6];
+	/** Next cell from every cell in each neighbour direction, including wraparound, for usedRadius */
+	int8_t neighbourQ[2 * MAX_RADIUS + 1][2 * MAX_RADIUS + 1][6];
+	int8_t neighbourR[2 * MAX_RADIUS + 1][2 * MAX_RADIUS + 1][6];
 
 	HexGrid() {
 		for (int q = 0; q < 2 * MAX_RADIUS + 1; q++) {
@@ -236,6 +252,11 @@ struct HexGrid {
 		return cellMap[hex.q][hex.r];
 	}
 
+	/** Returns the cell without copying, for use on the engine thread */
+	CELL& cellAt(RoundAxialVec hex) {
+		return cellMap[hex.q + MAX_RADIUS][hex.r + MAX_RADIUS];
+	}
+
 	void setCell(CELL c) {
 		RoundAxialVec index = axialToIndex(c.pos);
 		cellMap[index.q][index.r] = c;
@@ -256,6 +277,24 @@ struct HexGrid {
 	void setRadius(int r) {
 		usedRadius = r;
 		updateMirrorCenters();
+		updateNeighbours();
+	}
+
+	void updateNeighbours() {
+		for (int q = -MAX_RADIUS; q <= MAX_RADIUS; q++) {
+			for (int r = -MAX_RADIUS; r <= MAX_RADIUS; r++) {
+				for (int k = 0; k < 6; k++) {
+					RoundAxialVec n = RoundAxialVec(q + NEIGHBOUR_Q[k], r + NEIGHBOUR_R[k]);
+					if (!cellVisible(n, usedRadius))
+						n = wrap(n);
+					// Cells outside of the grid can only be found on corrupted patches, don't step off the map
+					if (!cellVisible(n, MAX_RADIUS))
+						n = RoundAxialVec(0, 0);
+					neighbourQ[q + MAX_RADIUS][r + MAX_RADIUS][k] = n.q;
+					neighbourR[q + MAX_RADIUS][r + MAX_RADIUS][k] = n.r;
+				}
+			}
+		}
 	}
 
 	void updateMirrorCenters() {
@@ -267,170 +306,32 @@ struct HexGrid {
 		mirrorCenters[5] = CubeVec(	-(2 * usedRadius + 1),	usedRadius + 1,			usedRadius);				// (-y, -z, -x)
 	}
 	
-	void wrapCursor(int id) {
-		CubeVec c = axialToCube(cursor[id].pos);
+	RoundAxialVec wrap(RoundAxialVec pos) {
+		CubeVec c = axialToCube(pos);
 		for (int i = 0; i < 6; i++) {
 			if (distance(c, mirrorCenters[i]) <= usedRadius) {					// If distance from mirror center i is less than distance to grid center
-				cursor[id].pos.q -= mirrorCenters[i].x;
-				cursor[id].pos.r -= mirrorCenters[i].z;
+				pos.q -= mirrorCenters[i].x;
+				pos.r -= mirrorCenters[i].z;
 			}
 		}
+		return pos;
+	}
+
+	void wrapCursor(int id) {
+		cursor.pos[id] = wrap(cursor.pos[id]);
 	}
 
 	void moveCursor(int id, int direction) {
 		// Direction is expressed as relative to the center of a clock, 0 through 11.
 		// For flat-top hexagons, odd-numbered directions are oriented between neighboring cells and thus alternate: first clockwise, then counter
 		// For pointy-top hexagons, it is the even-numbered directions which demand these alternating movements
-		if (CELL_SHAPE == ROTATION::FLAT) {
-			switch (direction) {
-				case 0:
-					cursor[id].pos.r -= 1;
-					break;
-				case 1:
-					if (!cursor[id].diagonalState) {
-						cursor[id].pos.q += 1;
-						cursor[id].pos.r -= 1;
-					}
-					else
-						cursor[id].pos.r -= 1;
-					cursor[id].diagonalState ^= true;
-					break;
-				case 2:
-					cursor[id].pos.q += 1;
-					cursor[id].pos.r -= 1;
-					break;
-				case 3:
-					if (!cursor[id].diagonalState)
-						cursor[id].pos.q += 1;
-					else {
-						cursor[id].pos.q += 1;
-						cursor[id].pos.r -= 1;
-					}
-					cursor[id].diagonalState ^= true;
-					break;
-				case 4:
-					cursor[id].pos.q += 1;
-					break;
-				case 5:
-					if (!cursor[id].diagonalState)
-						cursor[id].pos.r += 1;
-					else
-						cursor[id].pos.q += 1;
-					cursor[id].diagonalState ^= true;
-					break;
-				case 6:
-					cursor[id].pos.r += 1;
-					break;
-				case 7:
-					if (!cursor[id].diagonalState) {
-						cursor[id].pos.q -= 1;
-						cursor[id].pos.r += 1;
-					}
-					else
-						cursor[id].pos.r += 1;
-					cursor[id].diagonalState ^= true;
-					break;
-				case 8:
-					cursor[id].pos.q -= 1;
-					cursor[id].pos.r += 1;
-					break;
-				case 9:
-					if (!cursor[id].diagonalState)
-						cursor[id].pos.q -= 1;
-					else {
-						cursor[id].pos.q -= 1;
-						cursor[id].pos.r += 1;
-					}
-					cursor[id].diagonalState ^= true;
-					break;
-				case 10:
-					cursor[id].pos.q -= 1;
-					break;
-				case 11:
-					if (!cursor[id].diagonalState)
-						cursor[id].pos.r -= 1;
-					else
-						cursor[id].pos.q -= 1;
-					cursor[id].diagonalState ^= true;
-					break;
-			}
-		}
-		else {
-			switch (direction) {
-				case 0:
-					if (!cursor[id].diagonalState) {
-						cursor[id].pos.q += 1;
-						cursor[id].pos.r -= 1;
-					}
-					else
-						cursor[id].pos.r -= 1;
-					cursor[id].diagonalState ^= true;
-					break;
-				case 1:
-					cursor[id].pos.q += 1;
-					cursor[id].pos.r -= 1;
-					break;
-				case 2:
-					if (!cursor[id].diagonalState)
-						cursor[id].pos.q += 1;
-					else {
-						cursor[id].pos.q += 1;
-						cursor[id].pos.r -= 1;
-					}
-					cursor[id].diagonalState ^= true;
-					break;
-				case 3:
-					cursor[id].pos.q += 1;
-					break;
-				case 4:
-					if (!cursor[id].diagonalState)
-						cursor[id].pos.r += 1;
-					else
-						cursor[id].pos.q += 1;
-					cursor[id].diagonalState ^= true;
-					break;
-				case 5:
-					cursor[id].pos.r += 1;
-					break;
-				case 6:
-					if (!cursor[id].diagonalState) {
-						cursor[id].pos.q -= 1;
-						cursor[id].pos.r += 1;
-					}
-					else
-						cursor[id].pos.r += 1;
-					cursor[id].diagonalState ^= true;
-					break;
-				case 7:
-					cursor[id].pos.q -= 1;
-					cursor[id].pos.r += 1;
-					break;
-				case 8:
-					if (!cursor[id].diagonalState)
-						cursor[id].pos.q -= 1;
-					else {
-						cursor[id].pos.q -= 1;
-						cursor[id].pos.r += 1;
-					}
-					cursor[id].diagonalState ^= true;
-					break;
-				case 9:
-					cursor[id].pos.q -= 1;
-					break;
-				case 10:
-					if (!cursor[id].diagonalState)
-						cursor[id].pos.r -= 1;
-					else
-						cursor[id].pos.q -= 1;
-					cursor[id].diagonalState ^= true;
-					break;
-				case 11:
-					cursor[id].pos.r -= 1;
-					break;
-			}
-		}
-		if (!cellVisible(cursor[id].pos, usedRadius))
-			wrapCursor(id);
+		const int* step = CELL_SHAPE == ROTATION::FLAT ? FLAT_STEP[direction] : POINTY_STEP[direction];
+		int k = step[cursor.diagonalState[id]];
+		if (step[0] != step[1])
+			cursor.diagonalState[id] ^= true;
+		int q = cursor.pos[id].q + MAX_RADIUS;
+		int r = cursor.pos[id].r + MAX_RADIUS;
+		cursor.pos[id] = RoundAxialVec(neighbourQ[q][r][k], neighbourR[q][r][k]);
 	}
 
 	void drawGrid(float cellSizeFactor, Vec gridOrigin, NVGcontext* ctx) {
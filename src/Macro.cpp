@@ -4,13 +4,12 @@
 #include "components/VoltageLedDisplay.hpp"
 #include "components/Knobs.hpp"
 #include "ui/ParamWidgetContextExtender.hpp"
+#include "digital/ResponseCurve.hpp"
 
 namespace StoermelderPackOne {
 namespace Macro {
 
-static const int MAPS = 4;
-static const int CVPORTS = 2;
-
+template < int MAPS, int CVPORTS >
 struct MacroModule : CVMapModuleBase<MAPS> {
 	enum ParamIds {
 		ENUMS(PARAM_MAP, MAPS),
@@ -55,6 +54,10 @@ struct MacroModule : CVMapModuleBase<MAPS> {
 	ScaledMapParam<float> scaleParam[MAPS];
 	/** [Stored to Json] */
 	ScaledMapParam<float, CvParamQuantity> scaleCvs[CVPORTS];
+	/** [Stored to Json] */
+	ResponseCurve curveParam[MAPS];
+	/** [Stored to Json] */
+	ResponseCurve curveCvs[CVPORTS];
 
 	dsp::ClockDivider processDivider;
 	/** [Stored to JSON] */
@@ -67,21 +70,21 @@ struct MacroModule : CVMapModuleBase<MAPS> {
 
 	MacroModule() {
 		panelTheme = pluginSettings.panelThemeDefault;
-		config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS, NUM_LIGHTS);
-		configParam(PARAM_KNOB, 0.f, 1.f, 0.f, "Macro knob", "%", 0.f, 100.f);
+		Module::config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS, NUM_LIGHTS);
+		Module::configParam(PARAM_KNOB, 0.f, 1.f, 0.f, "Macro knob", "%", 0.f, 100.f);
 
 		for (size_t i = 0; i < MAPS; i++) {
-			configParam<MapParamQuantity<MacroModule>>(PARAM_MAP + i, 0.f, 1.f, 0.f, string::f("Map %i", i + 1));
-			MapParamQuantity<MacroModule>* pq = dynamic_cast<MapParamQuantity<MacroModule>*>(paramQuantities[PARAM_MAP + i]);
+			Module::configParam<MapParamQuantity<MacroModule>>(PARAM_MAP + i, 0.f, 1.f, 0.f, string::f("Map %i", i + 1));
+			MapParamQuantity<MacroModule>* pq = dynamic_cast<MapParamQuantity<MacroModule>*>(this->paramQuantities[PARAM_MAP + i]);
 			pq->module = this;
 			pq->id = i;
-			paramHandles[i].text = "MACRO";
+			this->paramHandles[i].text = "MACRO";
 			scaleParam[i].setLimits(0.f, 1.f, std::numeric_limits<float>::infinity());
 		}
 
 		for (size_t i = 0; i < CVPORTS; i++) {
 			CvParamQuantity* pq = new CvParamQuantity;
-			pq->output = &outputs[OUTPUT_CV + i];
+			pq->output = &this->outputs[OUTPUT_CV + i];
 			pq->minValue = 0.f;
 			pq->maxValue = 10.f;
 			scaleCvs[i].setParamQuantity(pq);
@@ -102,14 +105,16 @@ struct MacroModule : CVMapModuleBase<MAPS> {
 		CVMapModuleBase<MAPS>::onReset();
 		for (size_t i = 0; i < MAPS; i++) {
 			scaleParam[i].reset();
-			lastValue[i] = std::numeric_limits<float>::infinity();
+			curveParam[i].reset();
+			this->lastValue[i] = std::numeric_limits<float>::infinity();
 		}
 		for (size_t i = 0; i < CVPORTS; i++) {
 			CvParamQuantity* pq = scaleCvs[i].paramQuantity;
 			scaleCvs[i].reset();
 			scaleCvs[i].setParamQuantity(pq);
+			curveCvs[i].reset();
 		}
-		lockParameterChanges = false;
+		this->lockParameterChanges = false;
 		processDivision = 64;
 		processDivider.setDivision(processDivision);
 		processDivider.reset();
@@ -119,38 +124,39 @@ struct MacroModule : CVMapModuleBase<MAPS> {
 		if (processDivider.process()) {
 			float deltaTime = args.sampleTime * float(processDivision);
 
-			float v = params[PARAM_KNOB].getValue();
-			if (inputs[INPUT].isConnected()) {
-				float v1 = inputs[INPUT].getVoltage();
-				if (bipolarInput) v1 += 5.f;
+			float v = this->params[PARAM_KNOB].getValue();
+			if (this->inputs[INPUT].isConnected()) {
+				float v1 = this->inputs[INPUT].getVoltage();
+				if (this->bipolarInput) v1 += 5.f;
 				v = v * v1;
 				v = rescale(v, 0.f, 10.f, 0.f, 1.f);
 			}
 
 			for (size_t i = 0; i < MAPS; i++) {
-				ParamQuantity* paramQuantity = getParamQuantity(i);
+				ParamQuantity* paramQuantity = this->getParamQuantity(i);
 				scaleParam[i].setParamQuantity(paramQuantity);
 				if (paramQuantity) {
-					if (lastValue[i] != v) {
-						scaleParam[i].setValue(v);
-						lastValue[i] = v;
+					float c = curveParam[i].process(v);
+					if (this->lastValue[i] != c) {
+						scaleParam[i].setValue(c);
+						this->lastValue[i] = c;
 					}
-					scaleParam[i].process(deltaTime, lockParameterChanges);
+					scaleParam[i].process(deltaTime, this->lockParameterChanges);
 				}
 			}
 
 			for (size_t i = 0; i < CVPORTS; i++) {
-				if (!outputs[OUTPUT_CV + i].isConnected()) continue;
-				scaleCvs[i].setValue(v);
+				if (!this->outputs[OUTPUT_CV + i].isConnected()) continue;
+				scaleCvs[i].setValue(curveCvs[i].process(v));
 				scaleCvs[i].process(deltaTime);
 			}
 		}
 
 		if (lightDivider.process()) {
 			for (int i = 0; i < MAPS; i++) {
-				lights[LIGHT_MAP + i * 2].setBrightness(paramHandles[i].moduleId >= 0 && learningId != i ? 1.f : 0.f);
-				lights[LIGHT_MAP + i * 2 + 1].setBrightness(learningId == i ? 1.f : 0.f);
-				lights[LIGHT_MAP_CV + i].setBrightness(scaleParam[i].getLightBrightness());
+				this->lights[LIGHT_MAP + i * 2].setBrightness(this->paramHandles[i].moduleId >= 0 && this->learningId != i ? 1.f : 0.f);
+				this->lights[LIGHT_MAP + i * 2 + 1].setBrightness(this->learningId == i ? 1.f : 0.f);
+				this->lights[LIGHT_MAP_CV + i].setBrightness(scaleParam[i].getLightBrightness());
 			}
 		}
 
@@ -158,12 +164,12 @@ struct MacroModule : CVMapModuleBase<MAPS> {
 	}
 
 	void commitLearn() override {
-		if (learningId >= 0) {
-			scaleParam[learningId].reset();
-			lastValue[learningId] = std::numeric_limits<float>::infinity();
+		if (this->learningId >= 0) {
+			scaleParam[this->learningId].reset();
+			this->lastValue[this->learningId] = std::numeric_limits<float>::infinity();
 		}
 		CVMapModuleBase<MAPS>::commitLearn();
-		disableLearn(learningId);
+		this->disableLearn(this->learningId);
 	}
 
 	void setProcessDivision(int d) {
@@ -173,7 +179,7 @@ struct MacroModule : CVMapModuleBase<MAPS> {
 	}
 
 	float getCurrentVoltage() {
-		return inputs[INPUT].getVoltage();
+		return this->inputs[INPUT].getVoltage();
 	}
 
 	json_t* dataToJson() override {
@@ -189,6 +195,7 @@ struct MacroModule : CVMapModuleBase<MAPS> {
 			json_object_set_new(cvJ, "max", json_real(scaleCvs[i].getMax()));
 			json_object_set_new(cvJ, "bipolar", json_boolean(scaleCvs[i].paramQuantity->minValue == -5.f));
 			json_object_set_new(cvJ, "value", json_real(scaleCvs[i].paramQuantity->getScaledValue()));
+			json_object_set_new(cvJ, "curve", curveCvs[i].toJson());
 			json_array_append_new(cvsJ, cvJ);
 		}
 		json_object_set_new(rootJ, "cvs", cvsJ);
@@ -200,6 +207,7 @@ struct MacroModule : CVMapModuleBase<MAPS> {
 		json_object_set_new(mapJ, "slew", json_real(scaleParam[i].getSlew()));
 		json_object_set_new(mapJ, "min", json_real(scaleParam[i].getMin()));
 		json_object_set_new(mapJ, "max", json_real(scaleParam[i].getMax()));
+		json_object_set_new(mapJ, "curve", curveParam[i].toJson());
 	}
 
 	void dataFromJson(json_t* rootJ) override {
@@ -230,6 +238,8 @@ struct MacroModule : CVMapModuleBase<MAPS> {
 					scaleCvs[i].paramQuantity->minValue = bipolar ? -5.f : 0.f;
 					scaleCvs[i].paramQuantity->maxValue = bipolar ? 5.f : 10.f;
 				}
+				json_t* curveJ = json_object_get(cvJ, "curve");
+				if (curveJ) curveCvs[i].fromJson(curveJ);
 				json_t* valueJ = json_object_get(cvJ, "value");
 				if (valueJ) {
 					float v = json_real_value(valueJ);
@@ -248,12 +258,92 @@ struct MacroModule : CVMapModuleBase<MAPS> {
 		if (slewJ) scaleParam[i].setSlew(json_real_value(slewJ));
 		if (minJ) scaleParam[i].setMin(json_real_value(minJ));
 		if (maxJ) scaleParam[i].setMax(json_real_value(maxJ));
+		json_t* curveJ = json_object_get(mapJ, "curve");
+		if (curveJ) curveParam[i].fromJson(curveJ);
 	}
 };
 
 
-struct MacroButton : MapButton<MacroModule> {
+struct ResponseCurveMenuItem : MenuItem {
+	ResponseCurve* c;
+	ResponseCurveMenuItem() {
+		rightText = RIGHT_ARROW;
+	}
+
+	Menu* createChildMenu() override {
+		struct CurveItem : MenuItem {
+			ResponseCurve* c;
+			ResponseCurve::CURVE curve;
+			void onAction(const event::Action& e) override {
+				c->setCurve(curve);
+			}
+			void step() override {
+				rightText = CHECKMARK(c->getCurve() == curve);
+				MenuItem::step();
+			}
+		};
+
+		struct BreakpointSlider : ui::Slider {
+			struct BreakpointQuantity : Quantity {
+				ResponseCurve* c;
+				int i;
+				void setValue(float value) override {
+					c->setBreakpoint(i, value);
+					if (c->getCurve() != ResponseCurve::CURVE::TABLE) c->setCurve(ResponseCurve::CURVE::TABLE);
+				}
+				float getValue() override {
+					return c->getBreakpoint(i);
+				}
+				float getDefaultValue() override {
+					return float(i) / float(ResponseCurve::BREAKPOINTS - 1);
+				}
+				float getDisplayValue() override {
+					return getValue() * 100;
+				}
+				void setDisplayValue(float displayValue) override {
+					setValue(displayValue / 100);
+				}
+				std::string getLabel() override {
+					return string::f("Input %i%%", int(getDefaultValue() * 100));
+				}
+				std::string getUnit() override {
+					return "%";
+				}
+				int getDisplayPrecision() override {
+					return 3;
+				}
+			};
+
+			BreakpointSlider(ResponseCurve* c, int i) {
+				box.size.x = 220.0f;
+				quantity = construct<BreakpointQuantity>(&BreakpointQuantity::c, c, &BreakpointQuantity::i, i);
+			}
+			~BreakpointSlider() {
+				delete quantity;
+			}
+		};
+
+		Menu* menu = new Menu;
+		menu->addChild(construct<CurveItem>(&MenuItem::text, "Linear", &CurveItem::c, c, &CurveItem::curve, ResponseCurve::CURVE::LINEAR));
+		menu->addChild(construct<CurveItem>(&MenuItem::text, "Exponential", &CurveItem::c, c, &CurveItem::curve, ResponseCurve::CURVE::EXP));
+		menu->addChild(construct<CurveItem>(&MenuItem::text, "Logarithmic", &CurveItem::c, c, &CurveItem::curve, ResponseCurve::CURVE::LOG));
+		menu->addChild(construct<CurveItem>(&MenuItem::text, "S-curve", &CurveItem::c, c, &CurveItem::curve, ResponseCurve::CURVE::SCURVE));
+		menu->addChild(construct<CurveItem>(&MenuItem::text, "Breakpoint table", &CurveItem::c, c, &CurveItem::curve, ResponseCurve::CURVE::TABLE));
+		menu->addChild(new MenuSeparator());
+		menu->addChild(construct<MenuLabel>(&MenuLabel::text, "Breakpoint table"));
+		for (int i = 0; i < ResponseCurve::BREAKPOINTS; i++) {
+			menu->addChild(new BreakpointSlider(c, i));
+		}
+		return menu;
+	}
+}; // struct ResponseCurveMenuItem
+
+
+template < typename MODULE >
+struct MacroButton : MapButton<MODULE> {
 	void appendContextMenu(Menu* menu) override {
+		MODULE* module = this->module;
+		int id = this->id;
 		menu->addChild(new MenuSeparator());
 		menu->addChild(new MapSlewSlider<>(&module->scaleParam[id]));
 		menu->addChild(new MenuSeparator());
@@ -263,12 +353,14 @@ struct MacroButton : MapButton<MacroModule> {
 		menu->addChild(new MapMinSlider<>(&module->scaleParam[id]));
 		menu->addChild(new MapMaxSlider<>(&module->scaleParam[id]));
 		menu->addChild(construct<MapPresetMenuItem<>>(&MenuItem::text, "Preset", &MapPresetMenuItem<>::p, &module->scaleParam[id]));
+		menu->addChild(construct<ResponseCurveMenuItem>(&MenuItem::text, "Response curve", &ResponseCurveMenuItem::c, &module->curveParam[id]));
 	}
 }; // struct MacroButton
 
 
+template < typename MODULE >
 struct MacroPort : StoermelderPort {
-	typedef ScaledMapParam<float, MacroModule::CvParamQuantity> SCALE;
+	typedef ScaledMapParam<float, typename MODULE::CvParamQuantity> SCALE;
 	int id;
 
 	void onButton(const event::Button& e) override {
@@ -282,10 +374,10 @@ struct MacroPort : StoermelderPort {
 	}
 
 	void createContextMenu() {
-		MacroModule* module = dynamic_cast<MacroModule*>(this->module);
+		MODULE* module = dynamic_cast<MODULE*>(this->module);
 
 		struct BipolarItem : MenuItem {
-			MacroModule* module;
+			MODULE* module;
 			int id;
 			void onAction(const event::Action& e) override {
 				bool b = module->scaleCvs[id].paramQuantity->minValue == -5.f;
@@ -325,54 +417,67 @@ struct MacroPort : StoermelderPort {
 		menu->addChild(new MapMinSlider<SCALE>(&module->scaleCvs[id]));
 		menu->addChild(new MapMaxSlider<SCALE>(&module->scaleCvs[id]));
 		menu->addChild(construct<MapPresetMenuItem<SCALE>>(&MenuItem::text, "Presets", &MapPresetMenuItem<SCALE>::p, &module->scaleCvs[id]));
+		menu->addChild(construct<ResponseCurveMenuItem>(&MenuItem::text, "Response curve", &ResponseCurveMenuItem::c, &module->curveCvs[id]));
 		menu->addChild(new MenuSeparator());
 		menu->addChild(construct<DisconnectItem>(&MenuItem::text, "Disconnect", &DisconnectItem::pw, this));
 	}
 }; // struct MacroPort
 
 
-struct MacroWidget : ThemedModuleWidget<MacroModule>, ParamWidgetContextExtender {
-	typedef MacroModule MODULE;
-	MacroWidget(MODULE* module)
-		: ThemedModuleWidget<MODULE>(module, "Macro") {
-		setModule(module);
+template < typename MODULE >
+struct MacroWidgetBase : ThemedModuleWidget<MODULE>, ParamWidgetContextExtender {
+	typedef ThemedModuleWidget<MODULE> BASE;
 
-		addChild(createWidget<StoermelderBlackScrew>(Vec(RACK_GRID_WIDTH, 0)));
-		addChild(createWidget<StoermelderBlackScrew>(Vec(RACK_GRID_WIDTH, RACK_GRID_HEIGHT - RACK_GRID_WIDTH)));
+	MacroWidgetBase(MODULE* module, std::string baseName)
+		: ThemedModuleWidget<MODULE>(module, baseName, "Macro") {
+	}
 
+	/** Places the map buttons in columns of four rows, x is the center of each column */
+	void addMaps(MODULE* module, std::initializer_list<float> x) {
 		float o = 28.8f;
-		for (size_t i = 0; i < MAPS; i++) {
-			MacroButton* button = createParamCentered<MacroButton>(Vec(22.5f, 60.3f + o * i), module, MODULE::PARAM_MAP + i);
-			button->setModule(module);
-			button->id = i;
-			addParam(button);
-			addChild(createLightCentered<MapLight<GreenRedLight>>(Vec(22.5f, 60.3f + o * i), module, MODULE::LIGHT_MAP + i * 2));
-			addChild(createLightCentered<TinyLight<WhiteLight>>(Vec(33.6f, 50.7f + o * i), module, MODULE::LIGHT_MAP_CV + i));
+		int i = 0;
+		for (float xi : x) {
+			for (int j = 0; j < 4; j++, i++) {
+				MacroButton<MODULE>* button = createParamCentered<MacroButton<MODULE>>(Vec(xi, 60.3f + o * j), module, MODULE::PARAM_MAP + i);
+				button->setModule(module);
+				button->id = i;
+				BASE::addParam(button);
+				BASE::addChild(createLightCentered<MapLight<GreenRedLight>>(Vec(xi, 60.3f + o * j), module, MODULE::LIGHT_MAP + i * 2));
+				BASE::addChild(createLightCentered<TinyLight<WhiteLight>>(Vec(xi + 11.1f, 50.7f + o * j), module, MODULE::LIGHT_MAP_CV + i));
+			}
 		}
+	}
 
-		o = 28.1f;
-		for (size_t i = 0; i < CVPORTS; i++) {
-			MacroPort* p = createOutputCentered<MacroPort>(Vec(22.5f, 191.f + o * i), module, MODULE::OUTPUT_CV + i);
-			p->id = i;
-			addOutput(p);
+	/** Places the CV outputs in columns of two rows */
+	void addCvPorts(MODULE* module, std::initializer_list<float> x) {
+		float o = 28.1f;
+		int i = 0;
+		for (float xi : x) {
+			for (int j = 0; j < 2; j++, i++) {
+				MacroPort<MODULE>* p = createOutputCentered<MacroPort<MODULE>>(Vec(xi, 191.f + o * j), module, MODULE::OUTPUT_CV + i);
+				p->id = i;
+				BASE::addOutput(p);
+			}
 		}
+	}
 
-		addParam(createParamCentered<StoermelderLargeKnob>(Vec(22.5f, 260.7f), module, MODULE::PARAM_KNOB));
+	void addControls(MODULE* module, float x) {
+		BASE::addParam(createParamCentered<StoermelderLargeKnob>(Vec(x, 260.7f), module, MODULE::PARAM_KNOB));
 
-		VoltageLedDisplay<MODULE>* ledDisplay = createWidgetCentered<VoltageLedDisplay<MODULE>>(Vec(22.5f, 291.9f));
+		VoltageLedDisplay<MODULE>* ledDisplay = createWidgetCentered<VoltageLedDisplay<MODULE>>(Vec(x, 291.9f));
 		ledDisplay->box.size = Vec(39.1f, 13.2f);
 		ledDisplay->module = module;
-		addChild(ledDisplay);
-		addInput(createInputCentered<StoermelderPort>(Vec(22.5f, 327.9f), module, MODULE::INPUT));
+		BASE::addChild(ledDisplay);
+		BASE::addInput(createInputCentered<StoermelderPort>(Vec(x, 327.9f), module, MODULE::INPUT));
 	}
 
 	void step() override {
 		ParamWidgetContextExtender::step();
-		ThemedModuleWidget<MacroModule>::step();
+		BASE::step();
 	}
 
 	void appendContextMenu(Menu* menu) override {
-		ThemedModuleWidget<MODULE>::appendContextMenu(menu);
+		BASE::appendContextMenu(menu);
 		MODULE* module = dynamic_cast<MODULE*>(this->module);
 		assert(module);
 
@@ -442,6 +547,7 @@ struct MacroWidget : ThemedModuleWidget<MacroModule>, ParamWidgetContextExtender
 	void extendParamWidgetContextMenu(ParamWidget* pw, Menu* menu) override {
 		ParamQuantity* pq = pw->paramQuantity;
 		if (!pq) return;
+		MODULE* module = this->module;
 
 		for (int id = 0; id < module->mapLen; id++) {
 			if (module->paramHandles[id].moduleId == pq->module->id && module->paramHandles[id].paramId == pq->paramId) {
@@ -457,12 +563,46 @@ struct MacroWidget : ThemedModuleWidget<MacroModule>, ParamWidgetContextExtender
 				menu->addChild(new MapMinSlider<>(&module->scaleParam[id]));
 				menu->addChild(new MapMaxSlider<>(&module->scaleParam[id]));
 				menu->addChild(construct<MapPresetMenuItem<>>(&MenuItem::text, "Preset", &MapPresetMenuItem<>::p, &module->scaleParam[id]));
+				menu->addChild(construct<ResponseCurveMenuItem>(&MenuItem::text, "Response curve", &ResponseCurveMenuItem::c, &module->curveParam[id]));
 			}
 		}
 	}
+}; // struct MacroWidgetBase
+
+
+struct MacroWidget : MacroWidgetBase<MacroModule<4, 2>> {
+	typedef MacroModule<4, 2> MODULE;
+	MacroWidget(MODULE* module)
+		: MacroWidgetBase<MODULE>(module, "Macro") {
+		setModule(module);
+
+		addChild(createWidget<StoermelderBlackScrew>(Vec(RACK_GRID_WIDTH, 0)));
+		addChild(createWidget<StoermelderBlackScrew>(Vec(RACK_GRID_WIDTH, RACK_GRID_HEIGHT - RACK_GRID_WIDTH)));
+
+		addMaps(module, {22.5f});
+		addCvPorts(module, {22.5f});
+		addControls(module, 22.5f);
+	}
 }; // struct MacroWidget
 
+
+struct MacroX2Widget : MacroWidgetBase<MacroModule<8, 4>> {
+	typedef MacroModule<8, 4> MODULE;
+	MacroX2Widget(MODULE* module)
+		: MacroWidgetBase<MODULE>(module, "MacroX2") {
+		setModule(module);
+
+		addChild(createWidget<StoermelderBlackScrew>(Vec(RACK_GRID_WIDTH, 0)));
+		addChild(createWidget<StoermelderBlackScrew>(Vec(box.size.x - 2 * RACK_GRID_WIDTH, RACK_GRID_HEIGHT - RACK_GRID_WIDTH)));
+
+		addMaps(module, {22.5f, 67.5f});
+		addCvPorts(module, {22.5f, 67.5f});
+		addControls(module, 45.f);
+	}
+}; // struct MacroX2Widget
+
 } // namespace Macro
 } // namespace StoermelderPackOne
 
-Model* modelMacro = createModel<StoermelderPackOne::Macro::MacroModule, StoermelderPackOne::Macro::MacroWidget>("Macro");
\ No newline at end of file
+Model* modelMacro = createModel<StoermelderPackOne::Macro::MacroModule<4, 2>, StoermelderPackOne::Macro::MacroWidget>("Macro");
+Model* modelMacroX2 = createModel<StoermelderPackOne::Macro::MacroModule<8, 4>, StoermelderPackOne::Macro::MacroX2Widget>("MacroX2");
\ No newline at end of file
@@ -1,6 +1,5 @@
 #include "plugin.hpp"
 #include "digital.hpp"
-#include <random>
 
 namespace StoermelderPackOne {
 namespace Maze {
@@ -38,6 +37,8 @@ enum class MODULESTATE {
 
 template < int SIZE, int NUM_PORTS >
 struct MazeModule : Module {
+	static_assert(SIZE <= 32, "grid state of a column is packed into 64 bits");
+
 	enum ParamIds {
 		RESET_PARAM,
 		NUM_PARAMS
@@ -63,18 +64,21 @@ struct MazeModule : Module {
 
 	const int numPorts = NUM_PORTS;
 
-	std::default_random_engine randGen{(uint16_t)std::chrono::system_clock::now().time_since_epoch().count()};
-	std::geometric_distribution<int>* geoDist[NUM_PORTS] = {};
+	/** [Stored to JSON] seed of the cursors' random generators */
+	uint64_t seed;
+	CursorRandom cursorRandom[NUM_PORTS];
 
 	/** [Stored to JSON] */
 	int panelTheme = 0;
 
 	/** [Stored to JSON] */
 	int usedSize = 8;
-	/** [Stored to JSON] */
-	GRIDSTATE grid[SIZE][SIZE];
+	/** [Stored to JSON] state of all cells, 2 bits for each cell of a column */
+	uint64_t grid[SIZE];
 	/** [Stored to JSON] */
 	float gridCv[SIZE][SIZE];
+	/** Next position for each direction -1, 0 and 1 on either axis, wrapping around usedSize */
+	int wrapStep[3][SIZE];
 
 	/** [Stored to JSON] */
 	int xStartDir[NUM_PORTS];
@@ -129,17 +133,13 @@ struct MazeModule : Module {
 		panelTheme = pluginSettings.panelThemeDefault;
 		config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS, NUM_LIGHTS);
 		lightDivider.setDivision(128);
+		updateWrap();
 		onReset();
 	}
 
-	~MazeModule() {
-		for (int i = 0; i < NUM_PORTS; i++) {
-			delete geoDist[i];
-		}
-	}
-
 	void onReset() override {
 		gridClear();
+		setSeed(random::u64());
 		for (int i = 0; i < NUM_PORTS; i++) {
 			xPos[i] = xStartPos[i] = 0;
 			yPos[i] = yStartPos[i] = usedSize / NUM_PORTS * i;
@@ -160,14 +160,14 @@ struct MazeModule : Module {
 	void process(const ProcessArgs& args) override {
 		if (shiftRTrigger.process(inputs[SHIFT_R_INPUT].getVoltage())) {
 			for (int i = 0; i < NUM_PORTS; i++) {
-				xPos[i] = (xPos[i] + -1 * yDir[i] + usedSize) % usedSize;
-				yPos[i] = (yPos[i] +  1 * xDir[i] + usedSize) % usedSize;
+				xPos[i] = wrapStep[1 - yDir[i]][xPos[i]];
+				yPos[i] = wrapStep[1 + xDir[i]][yPos[i]];
 			}
 		}
 		if (shiftLTrigger.process(inputs[SHIFT_L_INPUT].getVoltage())) {
 			for (int i = 0; i < NUM_PORTS; i++) {
-				xPos[i] = (xPos[i] +  1 * yDir[i] + usedSize) % usedSize;
-				yPos[i] = (yPos[i] + -1 * xDir[i] + usedSize) % usedSize;
+				xPos[i] = wrapStep[1 + yDir[i]][xPos[i]];
+				yPos[i] = wrapStep[1 - xDir[i]][yPos[i]];
 			}
 		}
 
@@ -184,11 +184,11 @@ struct MazeModule : Module {
 			}
 
 			if (processClockTrigger(i, args.sampleTime)) {
-				xPos[i] = (xPos[i] + xDir[i] + usedSize) % usedSize;
-				yPos[i] = (yPos[i] + yDir[i] + usedSize) % usedSize;
+				xPos[i] = wrapStep[1 + xDir[i]][xPos[i]];
+				yPos[i] = wrapStep[1 + yDir[i]][yPos[i]];
 				multiplier[i].tick();
 
-				switch (grid[xPos[i]][yPos[i]]) {
+				switch (gridGet(xPos[i], yPos[i])) {
 					case GRIDSTATE::OFF:
 						break;
 					case GRIDSTATE::ON:
@@ -197,19 +197,19 @@ struct MazeModule : Module {
 					case GRIDSTATE::RANDOM:
 						switch (ratchetingEnabled[i]) {
 							case RATCHETMODE::OFF:
-								doPulse = random::uniform() >= 0.5f;
+								doPulse = cursorRandom[i].uniform() >= 0.5f;
 								break;
 							case RATCHETMODE::DEFAULT:
-								if (geoDist[i]) multiplier[i].trigger((*geoDist[i])(randGen));
+								multiplier[i].trigger(cursorRandom[i].geometric());
 								break;
 							case RATCHETMODE::MULT_TWO:
-								if (geoDist[i]) multiplier[i].trigger(2 * ((*geoDist[i])(randGen) + 1));
+								multiplier[i].trigger(2 * (cursorRandom[i].geometric() + 1));
 								break;
 							case RATCHETMODE::MULT_THREE:
-								if (geoDist[i]) multiplier[i].trigger(3 * ((*geoDist[i])(randGen) + 1));
+								multiplier[i].trigger(3 * (cursorRandom[i].geometric() + 1));
 								break;
 							case RATCHETMODE::POWER_TWO:
-								if (geoDist[i]) multiplier[i].trigger(std::pow(2, (*geoDist[i])(randGen)));
+								multiplier[i].trigger(1u << std::min(cursorRandom[i].geometric(), 31));
 								break;
 						}
 						break;
@@ -333,10 +333,26 @@ struct MazeModule : Module {
 		}
 	}
 
+	inline GRIDSTATE gridGet(int i, int j) {
+		return (GRIDSTATE)((grid[i] >> (2 * j)) & 3);
+	}
+
+	inline void gridSet(int i, int j, GRIDSTATE s) {
+		grid[i] = (grid[i] & ~(uint64_t(3) << (2 * j))) | (uint64_t(s) << (2 * j));
+	}
+
+	void updateWrap() {
+		for (int i = 0; i < SIZE; i++) {
+			for (int d = -1; d <= 1; d++) {
+				wrapStep[d + 1][i] = (i + d + usedSize) % usedSize;
+			}
+		}
+	}
+
 	void gridClear() {
 		for (int i = 0; i < SIZE; i++) {
+			grid[i] = 0;
 			for (int j = 0; j < SIZE; j++) {
-				grid[i][j] = GRIDSTATE::OFF;
 				gridCv[i][j] = 0.f;
 			}
 		}
@@ -346,6 +362,7 @@ struct MazeModule : Module {
 	void gridResize(int size) {
 		if (size == usedSize) return;
 		usedSize = size;
+		updateWrap();
 		for (int i = 0; i < NUM_PORTS; i++) {
 			xStartPos[i] = 0;
 			yStartPos[i] = usedSize / NUM_PORTS * i;
@@ -360,15 +377,15 @@ struct MazeModule : Module {
 			for (int j = 0; j < SIZE; j++) {
 				float r = random::uniform();
 				if (r > 0.8f) {
-					grid[i][j] = useRandom ? GRIDSTATE::RANDOM : GRIDSTATE::ON;
+					gridSet(i, j, useRandom ? GRIDSTATE::RANDOM : GRIDSTATE::ON);
 					gridCv[i][j] = random::uniform();
 				}
 				else if (r > 0.6f) {
-					grid[i][j] = GRIDSTATE::ON;
+					gridSet(i, j, GRIDSTATE::ON);
 					gridCv[i][j] = random::uniform();
 				}
 				else {
-					grid[i][j] = GRIDSTATE::OFF;
+					gridSet(i, j, GRIDSTATE::OFF);
 					gridCv[i][j] = 0.f;
 				}
 			}
@@ -377,24 +394,29 @@ struct MazeModule : Module {
 	}
 
 	void gridNextState(int i, int j) {
-		grid[i][j] = (GRIDSTATE)(((int)grid[i][j] + 1) % 3);
-		if (grid[i][j] == GRIDSTATE::ON) gridCv[i][j] = random::uniform();
+		gridSet(i, j, (GRIDSTATE)(((int)gridGet(i, j) + 1) % 3));
+		if (gridGet(i, j) == GRIDSTATE::ON) gridCv[i][j] = random::uniform();
 		gridDirty = true;
 	}
 
 	void gridSetState(int i, int j, GRIDSTATE s, float cv) {
-		grid[i][j] = s;
+		gridSet(i, j, s);
 		gridCv[i][j] = cv;
 		gridDirty = true;
 	}
 
 	void ratchetingSetProb(int id, float prob = 0.35f) {
-		auto geoDistOld = geoDist[id];
-		geoDist[id] = new std::geometric_distribution<int>(prob);
-		if (geoDistOld) delete geoDistOld;
+		cursorRandom[id].setGeometric(prob);
 		ratchetingProb[id] = prob;
 	}
 
+	void setSeed(uint64_t seed) {
+		this->seed = seed;
+		for (int i = 0; i < NUM_PORTS; i++) {
+			cursorRandom[i].seed(seed + i);
+		}
+	}
+
 	json_t* dataToJson() override {
 		json_t* rootJ = json_object();
 
@@ -403,7 +425,7 @@ struct MazeModule : Module {
 		json_t* gridJ = json_array();
 		for (int i = 0; i < SIZE; i++) {
 			for (int j = 0; j < SIZE; j++) {
-				json_array_append_new(gridJ, json_integer((int)grid[i][j]));
+				json_array_append_new(gridJ, json_integer((int)gridGet(i, j)));
 			}
 		}
 		json_object_set_new(rootJ, "grid", gridJ);
@@ -437,6 +459,7 @@ struct MazeModule : Module {
 
 		json_object_set_new(rootJ, "usedSize", json_integer(usedSize));
 		json_object_set_new(rootJ, "normalizePorts", json_boolean(normalizePorts));
+		json_object_set_new(rootJ, "seed", json_integer((json_int_t)seed));
 		return rootJ;
 	}
 
@@ -446,7 +469,7 @@ struct MazeModule : Module {
 		json_t* gridJ = json_object_get(rootJ, "grid");
 		for (int i = 0; i < SIZE; i++) {
 			for (int j = 0; j < SIZE; j++) {
-				grid[i][j] = (GRIDSTATE)json_integer_value(json_array_get(gridJ, i * SIZE + j));
+				gridSet(i, j, (GRIDSTATE)(json_integer_value(json_array_get(gridJ, i * SIZE + j)) & 3));
 			}
 		}
 		
@@ -479,9 +502,12 @@ struct MazeModule : Module {
 			}
 		}
 
-		usedSize = json_integer_value(json_object_get(rootJ, "usedSize"));
+		usedSize = clamp((int)json_integer_value(json_object_get(rootJ, "usedSize")), 2, SIZE);
+		updateWrap();
 		json_t* normalizePortsJ = json_object_get(rootJ, "normalizePorts");
 		if (normalizePortsJ) normalizePorts = json_boolean_value(normalizePortsJ);
+		json_t* seedJ = json_object_get(rootJ, "seed");
+		if (seedJ) setSeed((uint64_t)json_integer_value(seedJ));
 
 		json_t* ratchetingEnabledJ = json_object_get(rootJ, "ratchetingEnabled");
 		json_t* ratchetingProbJ = json_object_get(rootJ, "ratchetingProb");
@@ -692,7 +718,7 @@ struct MazeGridWidget : FramebufferWidget {
 			float stroke = 0.7f;
 			for (int i = 0; i < module->usedSize; i++) {
 				for (int j = 0; j < module->usedSize; j++) {
-					switch (module->grid[i][j]) {
+					switch (module->gridGet(i, j)) {
 						case GRIDSTATE::ON:
 							nvgBeginPath(args.vg);
 							nvgRect(args.vg, i * sizeX + stroke / 2.f, j * sizeY + stroke / 2.f, sizeX - stroke, sizeY - stroke);
@@ -1071,12 +1097,12 @@ struct MazeScreenWidget : LightWidget, MazeDrawHelper<MODULE> {
 				h->moduleId = module->id;
 				h->x = x;
 				h->y = y;
-				h->oldGrid = module->grid[x][y];
+				h->oldGrid = module->gridGet(x, y);
 				h->oldGridCv = module->gridCv[x][y];
 
 				module->gridNextState(x, y);
 				
-				h->newGrid = module->grid[x][y];
+				h->newGrid = module->gridGet(x, y);
 				h->newGridCv = module->gridCv[x][y];
 				APP->history->push(h);
 
@@ -50,6 +50,39 @@ struct MirrorModule : Module, StripIdFixModule {
 	/** [Stored to JSON] */
 	int cvParamId[8];
 
+	struct CopySource {
+		ParamHandle* handle;
+		/** Module of the handle at the time the copy plan was built */
+		Module* module;
+		ParamQuantity* paramQuantity;
+		float lastValue;
+		bool changed;
+	};
+
+	struct CopyItem {
+		int sourceIndex;
+		ParamHandle* handle;
+		/** Module of the handle at the time the copy plan was built */
+		Module* module;
+		ParamQuantity* paramQuantity;
+	};
+
+	/** Resolved source parameters, same order as sourceHandles */
+	std::vector<CopySource> copySources;
+	/** Resolved source-target pairs, ordered by source */
+	std::vector<CopyItem> copyItems;
+	/** Set when bindings have changed and the copy plan must be rebuilt */
+	bool copyPlanDirty = true;
+
+	/** Last voltage applied from each CV input */
+	float lastCv[8];
+
+	/** Number of parameter writes during the current second */
+	int writeCount = 0;
+	/** Number of parameter writes during the last second, for display */
+	int writesPerSecond = 0;
+	float writeCountTime = 0.f;
+
 	dsp::ClockDivider processDivider;
 	dsp::ClockDivider handleDivider;
 
@@ -90,9 +123,11 @@ struct MirrorModule : Module, StripIdFixModule {
 
 		for (int i = 0; i < 8; i++) {
 			cvParamId[i] = -1;
+			lastCv[i] = std::numeric_limits<float>::infinity();
 		}
 
 		targetModuleIds.clear();
+		copyPlanDirty = true;
 		inChange = false;
 
 		sourcePluginSlug = "";
@@ -122,38 +157,105 @@ struct MirrorModule : Module, StripIdFixModule {
 					j += sourceHandles.size();
 				}
 			}
+
+			// Rebuild the copy plan if any module has been added or removed since
+			for (size_t i = 0; i < copyItems.size() && !copyPlanDirty; i++) {
+				CopyItem& item = copyItems[i];
+				if (item.handle->module != item.module) {
+					copyPlanDirty = true;
+				}
+			}
 		}
 
 		if (audioRate || processDivider.process()) {
 			for (int i = 0; i < 8; i++) {
 				if (cvParamId[i] >= 0 && inputs[INPUT_CV + i].isConnected()) {
 					float v = clamp(inputs[INPUT_CV + i].getVoltage(), 0.f, 10.f);
+					// Skip unchanged voltages, the source parameter keeps its last value
+					if (v == lastCv[i]) continue;
 					ParamHandle* sourceHandle = sourceHandles[cvParamId[i]];
 					ParamQuantity* sourceParamQuantity = getParamQuantity(sourceHandle);
-					if (sourceParamQuantity)
+					if (sourceParamQuantity) {
 						sourceParamQuantity->setScaledValue(v / 10.f);
-					else 
+						lastCv[i] = v;
+						writeCount++;
+					}
+					else {
 						cvParamId[i] = -1;
+					}
+				}
+				else {
+					lastCv[i] = std::numeric_limits<float>::infinity();
 				}
 			}
 
-			for (ParamHandle* sourceHandle : sourceHandles) {
-				ParamQuantity* sourceParamQuantity = getParamQuantity(sourceHandle);
-				if (!sourceParamQuantity) continue;
-
-				float v = sourceParamQuantity->getValue();
+			if (copyPlanDirty) {
+				buildCopyPlan();
+			}
 
-				int i = sourceHandle->paramId;
-				while (i < (int)targetHandles.size()) {
-					ParamHandle* targetHandle = targetHandles[i];
-					ParamQuantity* targetParamQuantity = getParamQuantity(targetHandle);
-					if (targetParamQuantity)
-						targetParamQuantity->setValue(v);
+			for (CopySource& source : copySources) {
+				source.changed = false;
+				if (source.handle->module != source.module) {
+					// Module has been removed or the handle has been rebound
+					copyPlanDirty = true;
+					continue;
+				}
+				if (!source.paramQuantity) continue;
+				float v = source.paramQuantity->getValue();
+				source.changed = v != source.lastValue;
+				source.lastValue = v;
+			}
 
-					i += sourceHandles.size();
+			for (CopyItem& item : copyItems) {
+				CopySource& source = copySources[item.sourceIndex];
+				if (!source.changed) continue;
+				if (item.handle->module != item.module) {
+					copyPlanDirty = true;
+					continue;
+				}
+				if (item.paramQuantity) {
+					item.paramQuantity->setValue(source.lastValue);
+					writeCount++;
 				}
 			}
 		}
+
+		writeCountTime += args.sampleTime;
+		if (writeCountTime >= 1.f) {
+			writesPerSecond = writeCount;
+			writeCount = 0;
+			writeCountTime -= 1.f;
+		}
+	}
+
+	/** Resolves all bound handles into a flat list of source-target pairs */
+	void buildCopyPlan() {
+		copySources.clear();
+		copyItems.clear();
+		for (ParamHandle* sourceHandle : sourceHandles) {
+			CopySource source;
+			source.handle = sourceHandle;
+			source.module = sourceHandle->module;
+			source.paramQuantity = getParamQuantity(sourceHandle);
+			// Force propagation on the first pass
+			source.lastValue = std::numeric_limits<float>::infinity();
+			source.changed = false;
+			copySources.push_back(source);
+		}
+		for (size_t i = 0; i < copySources.size(); i++) {
+			size_t j = i;
+			while (j < targetHandles.size()) {
+				ParamHandle* targetHandle = targetHandles[j];
+				CopyItem item;
+				item.sourceIndex = i;
+				item.handle = targetHandle;
+				item.module = targetHandle->module;
+				item.paramQuantity = getParamQuantity(targetHandle);
+				copyItems.push_back(item);
+				j += sourceHandles.size();
+			}
+		}
+		copyPlanDirty = false;
 	}
 
 	ParamQuantity* getParamQuantity(ParamHandle* handle) {
@@ -194,6 +296,7 @@ struct MirrorModule : Module, StripIdFixModule {
 			sourceHandles.push_back(sourceHandle);
 		}
 
+		copyPlanDirty = true;
 		inChange = false;
 	}
 
@@ -214,6 +317,7 @@ struct MirrorModule : Module, StripIdFixModule {
 		}
 
 		targetModuleIds.push_back(m->id);
+		copyPlanDirty = true;
 		inChange = false;
 	}
 
@@ -222,6 +326,7 @@ struct MirrorModule : Module, StripIdFixModule {
 		while (handleClearTodo.size() > 0) {
 			ParamHandle* handle = handleClearTodo.shift();
 			APP->engine->updateParamHandle(handle, -1, 0, true);
+			copyPlanDirty = true;
 		}
 	}
 
@@ -366,6 +471,7 @@ struct MirrorModule : Module, StripIdFixModule {
 		}
 
 		idFixClearMap();
+		copyPlanDirty = true;
 		inChange = false;
 	}
 };
@@ -428,6 +534,14 @@ struct MirrorWidget : ThemedModuleWidget<MirrorModule> {
 			}
 		};
 
+		struct WritesLabel : MenuLabel {
+			MirrorModule* module;
+			void step() override {
+				text = string::f("Parameter writes: %i/s", module->writesPerSecond);
+				MenuLabel::step();
+			}
+		};
+
 		struct CvInputPortMenuItem : MenuItem {
 			MirrorModule* module;
 			CvInputPortMenuItem() {
@@ -447,6 +561,7 @@ struct MirrorWidget : ThemedModuleWidget<MirrorModule> {
 					int paramId;
 					void onAction(const event::Action& e) override {
 						module->cvParamId[id] = paramId;
+						module->lastCv[id] = std::numeric_limits<float>::infinity();
 					}
 					void step() override {
 						rightText = module->cvParamId[id] == paramId ? "✔" : "";
@@ -514,6 +629,7 @@ struct MirrorWidget : ThemedModuleWidget<MirrorModule> {
 		menu->addChild(new MenuSeparator());
 		menu->addChild(construct<AudioRateItem>(&MenuItem::text, "Audio rate processing", &AudioRateItem::module, module));
 		menu->addChild(construct<MappingIndicatorHiddenItem>(&MenuItem::text, "Hide mapping indicators", &MappingIndicatorHiddenItem::module, module));
+		menu->addChild(construct<WritesLabel>(&WritesLabel::module, module));
 		menu->addChild(new MenuSeparator());
 		menu->addChild(construct<BindSourceItem>(&MenuItem::text, "Bind source module (left)", &BindSourceItem::module, module));
 		menu->addChild(construct<BindTargetItem>(&MenuItem::text, "Map module (right)", &BindTargetItem::module, module));
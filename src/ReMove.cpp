@@ -2,12 +2,20 @@
 #include "MapModuleBase.hpp"
 #include <thread>
 #include <random>
+#include <mutex>
+#include <atomic>
 
 namespace StoermelderPackOne {
 namespace ReMove {
 
+/** default size of the recording buffer in samples */
 const int REMOVE_MAX_DATA = 64 * 1024;
 const int REMOVE_MAX_SEQ = 8;
+const int REMOVE_MAX_LANES = 8;
+/** maximum length of a sequence in samples when breakpoints are stored */
+const int REMOVE_MAX_TICKS = 1 << 24;
+/** maximum deviation of the breakpoint interpolation from the recorded values */
+const float REMOVE_POINTS_EPSILON = 1e-3f;
 
 enum RECMODE {
     RECMODE_TOUCH = 0,
@@ -56,12 +64,125 @@ enum PLAYMODE {
     PLAYMODE_SEQRANDOM = 4
 };
 
+enum STORAGEMODE {
+    STORAGEMODE_SAMPLES = 0,
+    STORAGEMODE_POINTS = 1
+};
+
+enum TOUCHEVENT {
+    TOUCHEVENT_DRAG = 0,
+    TOUCHEVENT_PARAM = 1,
+    TOUCHEVENT_RELEASE = 2
+};
+
 const int REMOVE_PLAYDIR_FWD = 1;
 const int REMOVE_PLAYDIR_REV = -1;
 const int REMOVE_PLAYDIR_NONE = 0;
 
 
-struct ReMoveModule : MapModuleBase<1> {
+/**
+ * Keeps released recording buffers for reuse by other instances, as buffers can get large
+ * when recording at audio rate. Thread-safe, but allocates memory so it should not be called
+ * on the engine thread. Retains at most the size of the largest buffer, any more is freed.
+ */
+struct BufferPool {
+    std::mutex mutex;
+    std::map<int, std::vector<float*>> buffers;
+    /** number of floats kept in released buffers */
+    size_t freeSize = 0;
+    size_t freeSizeMax = REMOVE_MAX_DATA * 64;
+
+    float* acquire(int size) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<float*>& free = buffers[size];
+        if (free.empty()) return new float[size];
+        float* b = free.back();
+        free.pop_back();
+        freeSize -= size;
+        return b;
+    }
+
+    void release(float* b, int size) {
+        if (!b) return;
+        std::lock_guard<std::mutex> lock(mutex);
+        if (freeSize + size > freeSizeMax) {
+            delete[] b;
+            return;
+        }
+        buffers[size].push_back(b);
+        freeSize += size;
+    }
+};
+
+inline BufferPool& bufferPool() {
+    static BufferPool pool;
+    return pool;
+}
+
+
+/**
+ * Reduces a stream of samples to breakpoints of a piecewise linear curve, using the
+ * swing-door method: The recorded samples never deviate from the interpolated curve
+ * by more than epsilon. Needs constant memory and time for every sample.
+ */
+struct PointCompressor {
+    int n = 0;
+    /** last breakpoint */
+    float tp, vp;
+    /** last sample */
+    float tq, vq;
+    /** range of slopes from the last breakpoint to hit all samples since */
+    float slopeLow, slopeHigh;
+
+    void reset() {
+        n = 0;
+    }
+
+    /** Processes the sample v at time t, returns true if a breakpoint (ot, ov) has been found */
+    bool process(float t, float v, float &ot, float &ov) {
+        if (n++ == 0) {
+            tp = tq = ot = t;
+            vp = vq = ov = v;
+            slopeLow = -INFINITY;
+            slopeHigh = INFINITY;
+            return true;
+        }
+        float dt = t - tp;
+        float low = std::max(slopeLow, (v - REMOVE_POINTS_EPSILON - vp) / dt);
+        float high = std::min(slopeHigh, (v + REMOVE_POINTS_EPSILON - vp) / dt);
+        bool r = false;
+        if (low > high) {
+            // The line can't be continued, end it at the last sample and start a new one
+            vp = vp + (slopeLow + slopeHigh) / 2.f * (tq - tp);
+            tp = tq;
+            ot = tp;
+            ov = vp;
+            r = true;
+            dt = t - tp;
+            low = (v - REMOVE_POINTS_EPSILON - vp) / dt;
+            high = (v + REMOVE_POINTS_EPSILON - vp) / dt;
+        }
+        slopeLow = low;
+        slopeHigh = high;
+        tq = t;
+        vq = v;
+        return r;
+    }
+
+    /** Returns true and the final breakpoint (ot, ov) if there is one pending */
+    bool flush(float &ot, float &ov) {
+        bool r = n > 1 && tq > tp;
+        if (r) {
+            ot = tq;
+            ov = vp + (slopeLow + slopeHigh) / 2.f * (tq - tp);
+        }
+        n = 0;
+        return r;
+    }
+};
+
+
+struct ReMoveModule : MapModuleBase<REMOVE_MAX_LANES> {
     enum ParamIds {
         RUN_PARAM,
         RESET_PARAM,
@@ -96,11 +217,42 @@ struct ReMoveModule : MapModuleBase<1> {
     /** [Stored to JSON] */
     int panelTheme = 0;
 
-    /** [Stored to JSON] recorded data */
+    /** [Stored to JSON] recorded data, one column of laneSize values for every lane */
     float *seqData;
-    /** stores the current position in data */
+    /** [Stored to JSON] precision of recorded samples in the patch, 32 for floats or 16 */
+    int dataBits = 32;
+    /** [Stored to JSON] size of the recording buffer */
+    int dataSize = REMOVE_MAX_DATA;
+    /** buffer of a different size to be swapped in by the engine thread, the size is written before */
+    std::atomic<float*> seqDataNext{NULL};
+    int seqDataNextSize;
+    /** buffer swapped out by the engine thread, to be returned to the pool on the GUI thread */
+    std::atomic<float*> seqDataOld{NULL};
+    int seqDataOldSize;
+    /** recorder state loaded from JSON, restored on the GUI thread once the engine uses a buffer of its size */
+    json_t *recNextJ = NULL;
+    /** recording has wrapped around the end of the sequence */
+    bool recWrapped = false;
+    /** position of the oldest sample in every sequence recorded wrapped, instead of moving the data */
+    int seqHead[REMOVE_MAX_SEQ];
+    /** stores the current position in data, shared by all lanes */
     int dataPtr = 0;
 
+    /** [Stored to JSON] store every sample or breakpoints only */
+    STORAGEMODE storageMode = STORAGEMODE_SAMPLES;
+    /** [Stored to JSON] number of breakpoints of every lane and sequence, pairs of time and value */
+    int pointCount[REMOVE_MAX_LANES][REMOVE_MAX_SEQ];
+    /** segment of the breakpoints used on last playback, for each lane */
+    int pointCursor[REMOVE_MAX_LANES];
+    PointCompressor pointCompressor[REMOVE_MAX_LANES];
+
+    /** [Stored to JSON] number of lanes recorded simultaneously */
+    int laneCount = 1;
+    /** number of values available for each lane */
+    int laneSize = REMOVE_MAX_DATA;
+    /** number of lanes to be applied by the engine thread, 0 if unchanged */
+    std::atomic<int> laneCountNext{0};
+
     /** [Stored to JSON] number of sequences */
     int seqCount = 4;
     /** [Stored to JSON] currently selected sequence */
@@ -129,12 +281,19 @@ struct ReMoveModule : MapModuleBase<1> {
     /** [Stored to JSON] recording mode */
     RECMODE recMode = RECMODE_TOUCH;
     bool recTouched = false;
-    float recTouch;
+    float recTouch[REMOVE_MAX_LANES];
     /** [Stored to JSON] autoplay after record */
     bool recAutoplay;
 
     /** [Stored to JSON] sample rate for recording */
     float sampleRate = 1.f/60.f;
+    /** [Stored to JSON] record and play every engine sample, ignores sampleRate */
+    bool audioRate = false;
+    /** [Stored to JSON] interpolate linearly between samples on playback */
+    bool interpolate = false;
+    /** last position and sequence put out on playback, for interpolation */
+    int playPtr = -1;
+    int playSeq = -1;
 
     bool locked = false;
 
@@ -163,12 +322,16 @@ struct ReMoveModule : MapModuleBase<1> {
     dsp::BooleanTrigger recTrigger;
     dsp::PulseGenerator outCvPulse;
 
-    dsp::SlewLimiter slewLimiter;
+    dsp::SlewLimiter slewLimiter[REMOVE_MAX_LANES];
 
 	dsp::ClockDivider lightDivider;
 
-    /** last touched parameter to avoid frequent dynamic casting */
-    Widget *lastParamWidget;
+    /** drag events posted by the widget, the UI state must not be read on the engine thread */
+    dsp::RingBuffer<TOUCHEVENT, 16> touchQueue;
+    /** any widget is being dragged */
+    bool touchDragging = false;
+    /** a mapped parameter is being dragged */
+    bool touchParam = false;
 
     /** history-item when starting recording */
     history::ModuleChange *recChangeHistory = NULL;
@@ -183,19 +346,28 @@ struct ReMoveModule : MapModuleBase<1> {
         configParam<TriggerParamQuantity>(REC_PARAM, 0.0f, 1.0f, 0.0f, "Record");
         configParam(SLEW_PARAM, 0.0f, 0.975f, 0.0f, "Slew");
 
-        seqData = new float[REMOVE_MAX_DATA];
+        engineSampleTime = APP->engine->getSampleTime();
+        seqData = bufferPool().acquire(dataSize);
         this->mappingIndicatorColor = nvgRGB(0x40, 0xff, 0xff);
-        paramHandles[0].text = "ReMove Lite";
+        for (int i = 0; i < REMOVE_MAX_LANES; i++) {
+            paramHandles[i].text = "ReMove Lite";
+        }
 
         lightDivider.setDivision(1024);
         onReset();
     }
 
     ~ReMoveModule() {
-        delete[] seqData;
+        bufferPool().release(seqData, dataSize);
+        bufferPool().release(seqDataNext.load(), seqDataNextSize);
+        bufferPool().release(seqDataOld.load(), seqDataOldSize);
+        if (recNextJ) json_decref(recNextJ);
     }
 
     void onReset() override {
+        if (recNextJ) json_decref(recNextJ);
+        recNextJ = NULL;
+        laneCountNext.store(1, std::memory_order_release);
         MapModuleBase::onReset();
         isPlaying = false;
         playDir = REMOVE_PLAYDIR_FWD;
@@ -206,18 +378,42 @@ struct ReMoveModule : MapModuleBase<1> {
         sampleTimer.reset();
         seq = 0;
         seqResize(4);
-        valueFilters[0].reset();
+        for (int i = 0; i < REMOVE_MAX_LANES; i++) {
+            valueFilters[i].reset();
+        }
     }
 
     void process(const ProcessArgs &args) override {
         engineSampleTime = args.sampleTime;
         outputs[REC_OUTPUT].setVoltage(0);
 
+        float* next = seqDataNext.load(std::memory_order_acquire);
+        if (next && !isRecording && !seqDataOld.load(std::memory_order_acquire)) {
+            // Buffer size has been changed on the GUI thread, the swap waits for the end of a recording
+            seqDataOldSize = dataSize;
+            seqDataOld.store(seqData, std::memory_order_release);
+            seqData = next;
+            dataSize = seqDataNextSize;
+            laneSize = dataSize / laneCount;
+            seqResize(seqCount);
+            seqDataNext.store(NULL, std::memory_order_release);
+        }
+        int c = laneCountNext.load(std::memory_order_acquire);
+        if (c > 0 && !isRecording) {
+            // Number of lanes has been changed on the GUI thread, waits for the end of a recording
+            laneCount = c;
+            laneSize = dataSize / laneCount;
+            seqResize(seqCount);
+            updateMapLen();
+            // A newer request of the GUI is applied on the next sample
+            laneCountNext.compare_exchange_strong(c, 0, std::memory_order_release);
+        }
+        outputs[CV_OUTPUT].setChannels(outCvMode == OUTCVMODE_EOC ? 1 : laneCount);
+
         // Toggle record when button is pressed
         if (recTrigger.process(params[REC_PARAM].getValue() + inputs[REC_INPUT].getVoltage())) {
             isPlaying = false;
-            ParamQuantity *paramQuantity = getParamQuantity(0);
-            if (paramQuantity != NULL) {
+            if (isMapped()) {
                 isRecording ^= true;
                 if (isRecording) {
                     startRecording();
@@ -229,24 +425,23 @@ struct ReMoveModule : MapModuleBase<1> {
             }
         }
 
+        while (!touchQueue.empty()) {
+            TOUCHEVENT e = touchQueue.shift();
+            touchDragging = e != TOUCHEVENT_RELEASE;
+            touchParam = e == TOUCHEVENT_PARAM;
+        }
+
         if (isRecording) {
             bool doRecord = true;
 
             if (recMode == RECMODE_TOUCH && !recTouched) {
                 // check if mouse has been pressed on parameter
-                Widget *w = APP->event->getDraggedWidget();
-                if (w != NULL && w != lastParamWidget) {
-                    lastParamWidget = w;
-                    // it is not a good idea to do dynamic casting in the DSP thread,
-                    // so do this only once for each touched widget
-                    ParamWidget *pw = dynamic_cast<ParamWidget*>(w);
-                    if (pw != NULL && pw->paramQuantity == getParamQuantity(0)) {
-                        recTouched = true;
-                        recOutCvPulse.trigger();
-                    }
-                    else {
-                        doRecord = false;
-                    }
+                if (touchParam) {
+                    recTouched = true;
+                    recOutCvPulse.trigger();
+                    // take the first sample as soon as the touch arrives, which is up to one
+                    // GUI frame after the actual mouse press as drags are detected once per frame
+                    sampleTimer.time = sampleRate;
                 }
                 else {
                     doRecord = false;
@@ -254,9 +449,13 @@ struct ReMoveModule : MapModuleBase<1> {
             }
 
             if (recMode == RECMODE_MOVE && !recTouched) {
-                // check if param value has changed
-                if (getValue() != recTouch) {
-                    recTouched = true;
+                // check if the value of any lane has changed
+                for (int i = 0; i < laneCount; i++) {
+                    if (getValue(i) != recTouch[i]) {
+                        recTouched = true;
+                    }
+                }
+                if (recTouched) {
                     recOutCvPulse.trigger();
                 }
                 else {
@@ -265,40 +464,46 @@ struct ReMoveModule : MapModuleBase<1> {
             }
 
             if (doRecord) {
-                if (sampleTimer.process(args.sampleTime) > sampleRate) {
+                if (processSampleTimer(args.sampleTime)) {
                     // check if mouse button has been released
-                    if (APP->event->getDraggedWidget() == NULL) {
+                    if (!touchDragging) {
                         if (recMode == RECMODE_TOUCH) {
                             stopRecording();
                         }
                         if (recMode == RECMODE_MOVE) {
                             stopRecording();
-                            // trim unchanged values from the end
-                            int i = seqLow + seqLength[seq] - 1;
-                            if (i > seqLow) {
-                                float l = seqData[i];
-                                while (i > seqLow && l == seqData[i - 1]) i--;
-                                seqLength[seq] = i - seqLow;
-                            }
+                            seqTrim();
                         } 
                     }
                     
                     // Are we still recording?
                     if (isRecording) {
-                        seqData[dataPtr] = getValue();
-
-                        // Push value on parameter only when CV input is been used
-                        ParamQuantity* paramQuantity = NULL;
-                        if (inputs[CV_INPUT].isConnected()) paramQuantity = getParamQuantity(0);
-                        setValue(seqData[dataPtr], paramQuantity);
-                        seqLength[seq]++;
+                        for (int i = 0; i < laneCount; i++) {
+                            float v = getValue(i);
+                            recordValue(i, v);
+
+                            // Push value on parameter only when CV input is been used
+                            ParamQuantity* paramQuantity = NULL;
+                            if (inputs[CV_INPUT].isConnected()) paramQuantity = getParamQuantity(i);
+                            setValue(i, v, paramQuantity);
+                        }
+                        if (!recWrapped) seqLength[seq]++;
                         dataPtr++;
-                        // Stop recording when end of sequence is reached
-                        if (dataPtr == seqHigh) {
-                            stopRecording();
+                        // Stop recording when end of sequence is reached, at audio rate keep the latest samples
+                        if (isRecordingFull()) {
+                            if (audioRate && storageMode == STORAGEMODE_SAMPLES && recMode != RECMODE_SAMPLEHOLD) {
+                                dataPtr = seqLow;
+                                seqLength[seq] = seqHigh - seqLow;
+                                recWrapped = true;
+                            }
+                            else {
+                                stopRecording();
+                            }
                         }
                         if (recMode == RECMODE_SAMPLEHOLD) {
-                            seqData[dataPtr] = seqData[dataPtr - 1];
+                            for (int i = 0; i < laneCount; i++) {
+                                recordValue(i, value(i, dataPtr - 1));
+                            }
                             seqLength[seq]++;
                             stopRecording();
                         }
@@ -326,8 +531,11 @@ struct ReMoveModule : MapModuleBase<1> {
             if (resetCvTrigger.process(params[RESET_PARAM].getValue() + inputs[RESET_INPUT].getVoltage())) {
                 dataPtr = seqLow;
                 playDir = REMOVE_PLAYDIR_FWD;
+                playPtr = -1;
                 sampleTimer.reset();
-                valueFilters[0].reset();
+                for (int i = 0; i < laneCount; i++) {
+                    valueFilters[i].reset();
+                }
                 resetCvTimer.reset();
             }
 
@@ -350,6 +558,7 @@ struct ReMoveModule : MapModuleBase<1> {
             // RUN-button: toggle playing when button is pressed
             if (runTrigger.process(params[RUN_PARAM].getValue())) {
                 isPlaying ^= true;
+                playPtr = -1;
                 sampleTimer.reset();
             }
 
@@ -369,26 +578,29 @@ struct ReMoveModule : MapModuleBase<1> {
             // PHASE-input: if position-input is connected set the position directly, ignore playing
             if (inputs[PHASE_INPUT].isConnected()) {
                 isPlaying = false;
-                ParamQuantity *paramQuantity = getParamQuantity(0);
-                if (paramQuantity != NULL) {
+                if (isMapped()) {
                     float v = clamp(inputs[PHASE_INPUT].getVoltage(), 0.f, 10.f);
                     dataPtr = floor(rescale(v, 0.f, 10.f, seqLow, seqLow + seqLength[seq] - 1));
-                    v = seqData[dataPtr];
-                    setValue(v, paramQuantity);
+                    for (int i = 0; i < laneCount; i++) {
+                        setValue(i, value(i, dataPtr), getParamQuantity(i));
+                    }
                 }
             }
 
             if (isPlaying) {
-                if (sampleTimer.process(args.sampleTime) > sampleRate) {
-                    ParamQuantity *paramQuantity = getParamQuantity(0);
-                    if (paramQuantity == NULL)
+                if (processSampleTimer(args.sampleTime)) {
+                    if (!isMapped())
                         isPlaying = false;
 
                     // are we still playing?
                     if (isPlaying && seqLength[seq] > 0) {
-                        float v = seqData[dataPtr];
+                        int p = dataPtr;
                         dataPtr = dataPtr + playDir;
-                        setValue(v, paramQuantity);
+                        for (int i = 0; i < laneCount; i++) {
+                            setValue(i, value(i, p), getParamQuantity(i));
+                        }
+                        playPtr = p;
+                        playSeq = seq;
                         if (dataPtr == seqLow + seqLength[seq] && playDir == REMOVE_PLAYDIR_FWD) {
                             switch (playMode) {
                                 case PLAYMODE_LOOP: 
@@ -409,12 +621,23 @@ struct ReMoveModule : MapModuleBase<1> {
                     }
                     sampleTimer.reset();
                 }
+                else if (interpolate && !audioRate && playSeq == seq && playPtr >= seqLow && seqLength[seq] > 0) {
+                    // Move towards the next sample on every engine sample
+                    float f = clamp(sampleTimer.time / sampleRate, 0.f, 1.f);
+                    for (int i = 0; i < laneCount; i++) {
+                        float v = crossfade(value(i, playPtr), value(i, dataPtr), f);
+                        setValue(i, v, getParamQuantity(i), args.sampleTime);
+                    }
+                }
                 processSetValue();
             }
             else {
                 // Not playing and not recording -> bypass input to output for empty sequences
-                if (seqLength[seq] == 0)
-                    setValue(getValue());
+                if (seqLength[seq] == 0) {
+                    for (int i = 0; i < laneCount; i++) {
+                        setValue(i, getValue(i));
+                    }
+                }
             }
         }
 
@@ -447,34 +670,174 @@ struct ReMoveModule : MapModuleBase<1> {
         MapModuleBase::process(args);
     }
 
-    inline float getValue() {
+    /** Returns the time between two recorded samples */
+    inline float getSamplePeriod() {
+        return audioRate ? engineSampleTime : sampleRate;
+    }
+
+    /** Returns true if the next sample is due */
+    inline bool processSampleTimer(float dt) {
+        if (audioRate) return true;
+        return sampleTimer.process(dt) > sampleRate;
+    }
+
+    /** Returns the recorded values of a lane, indexed like dataPtr */
+    inline float* laneData(int lane) {
+        return &seqData[lane * laneSize];
+    }
+
+    /** Checks if any lane is mapped to a parameter */
+    inline bool isMapped() {
+        for (int i = 0; i < laneCount; i++) {
+            if (getParamQuantity(i) != NULL) return true;
+        }
+        return false;
+    }
+
+    inline bool isLaneParam(ParamQuantity* paramQuantity) {
+        for (int i = 0; i < laneCount; i++) {
+            if (paramQuantity == getParamQuantity(i)) return true;
+        }
+        return false;
+    }
+
+    /** Returns the index in the lane data of position pos of the current sequence, recorded as ring */
+    inline int seqIndex(int pos) {
+        int h = seqHead[seq];
+        if (h == 0) return pos;
+        return seqLow + (pos - seqLow + h) % (seqHigh - seqLow);
+    }
+
+    /** Returns the value of a lane at position pos of the current sequence */
+    inline float value(int lane, int pos) {
+        return value(lane, pos, pointCursor[lane]);
+    }
+
+    /** Returns the value of a lane at position pos, the cursor keeps the last breakpoint segment */
+    inline float value(int lane, int pos, int &cursor) {
+        float* data = laneData(lane);
+        if (storageMode == STORAGEMODE_SAMPLES) return data[seqIndex(pos)];
+
+        int n = pointCount[lane][seq];
+        if (n == 0) return 0.f;
+        float* points = &data[seqLow];
+        float t = pos - seqLow;
+        // Playback is moving slowly in both directions, so walk the segments starting at the last one
+        cursor = clamp(cursor, 0, n - 1);
+        while (cursor > 0 && points[2 * cursor] > t) cursor--;
+        while (cursor < n - 1 && points[2 * (cursor + 1)] <= t) cursor++;
+        if (cursor == n - 1 || t <= points[2 * cursor]) return points[2 * cursor + 1];
+        float t0 = points[2 * cursor];
+        float t1 = points[2 * (cursor + 1)];
+        float v = crossfade(points[2 * cursor + 1], points[2 * cursor + 3], (t - t0) / (t1 - t0));
+        return clamp(v, 0.f, 1.f);
+    }
+
+    /** Stores the value of a lane at the current position while recording */
+    inline void recordValue(int lane, float v) {
+        if (storageMode == STORAGEMODE_SAMPLES) {
+            laneData(lane)[dataPtr] = v;
+            return;
+        }
+        float ot, ov;
+        if (pointCompressor[lane].process(dataPtr - seqLow, v, ot, ov)) {
+            pushPoint(lane, seq, ot, ov);
+        }
+    }
+
+    inline void pushPoint(int lane, int s, float t, float v) {
+        float* points = &laneData(lane)[s * (laneSize / seqCount)];
+        int &n = pointCount[lane][s];
+        points[2 * n] = t;
+        points[2 * n + 1] = v;
+        n++;
+    }
+
+    /** Writes the last pending breakpoint of every lane */
+    void recordFlush() {
+        if (storageMode == STORAGEMODE_SAMPLES) return;
+        for (int i = 0; i < laneCount; i++) {
+            float ot, ov;
+            if (pointCompressor[i].flush(ot, ov)) {
+                pushPoint(i, seq, ot, ov);
+            }
+        }
+    }
+
+    /** Checks if there is no space left for another sample in the current sequence */
+    inline bool isRecordingFull() {
+        if (storageMode == STORAGEMODE_SAMPLES) return dataPtr == seqHigh;
+        if (dataPtr - seqLow >= REMOVE_MAX_TICKS) return true;
+        // keep space for two more breakpoints, one for the next sample and one for the flush
+        int m = (seqHigh - seqLow) / 2 - 2;
+        for (int i = 0; i < laneCount; i++) {
+            if (pointCount[i][seq] >= m) return true;
+        }
+        return false;
+    }
+
+    /** Removes values unchanged on all lanes from the end of the current sequence */
+    void seqTrim() {
+        if (storageMode == STORAGEMODE_SAMPLES) {
+            int i = seqLow + seqLength[seq] - 1;
+            if (i > seqLow) {
+                while (i > seqLow && isUnchanged(i)) i--;
+                seqLength[seq] = i - seqLow;
+            }
+            return;
+        }
+        int l = 0;
+        for (int i = 0; i < laneCount; i++) {
+            float* points = &laneData(i)[seqLow];
+            int n = pointCount[i][seq];
+            if (n == 0) continue;
+            // the last segment is flat if both breakpoints have (almost) the same value
+            int k = n - 1;
+            if (k > 0 && std::abs(points[2 * k + 1] - points[2 * k - 1]) <= REMOVE_POINTS_EPSILON)
+                l = std::max(l, (int)points[2 * (k - 1)]);
+            else
+                l = std::max(l, seqLength[seq]);
+        }
+        seqLength[seq] = std::min(seqLength[seq], l);
+    }
+
+    /** Checks if the values at position i are the same as the values before on all lanes */
+    inline bool isUnchanged(int i) {
+        for (int j = 0; j < laneCount; j++) {
+            float* data = laneData(j);
+            if (data[seqIndex(i)] != data[seqIndex(i - 1)]) return false;
+        }
+        return true;
+    }
+
+    inline float getValue(int lane) {
         float v = 0.f;
         if (inputs[CV_INPUT].isConnected()) {
             switch (inCvMode) {
                 case INCVMODE_UNI:
-                    v = rescale(clamp(inputs[CV_INPUT].getVoltage(), 0.f, 10.f), 0.f, 10.f, 0.f, 1.f);
+                    v = rescale(clamp(inputs[CV_INPUT].getPolyVoltage(lane), 0.f, 10.f), 0.f, 10.f, 0.f, 1.f);
                     break;
                 case INCVMODE_BI:
-                    v = rescale(clamp(inputs[CV_INPUT].getVoltage(), -5.f, 5.f), -5.f, 5.f, 0.f, 1.f);
+                    v = rescale(clamp(inputs[CV_INPUT].getPolyVoltage(lane), -5.f, 5.f), -5.f, 5.f, 0.f, 1.f);
                     break;
             }
         }
         else {
-            ParamQuantity *paramQuantity = getParamQuantity(0);
+            ParamQuantity *paramQuantity = getParamQuantity(lane);
             if (paramQuantity) {
                 v = paramQuantity->getScaledValue();
-                v = valueFilters[0].process(engineSampleTime, v);
+                v = valueFilters[lane].process(engineSampleTime, v);
             }
         }
         return v;
     }
 
-    inline void setValue(float v, ParamQuantity *paramQuantity = NULL) {
-        //v = valueFilters[0].process(sampleTime, v);
+    inline void setValue(int lane, float v, ParamQuantity *paramQuantity = NULL, float dt = 0.f) {
+        //v = valueFilters[lane].process(sampleTime, v);
         if (params[SLEW_PARAM].getValue() > 0.f) {
             float s = 100.f * (1.f - params[SLEW_PARAM].getValue());
-            slewLimiter.setRiseFall(s, s);
-            v = slewLimiter.process(sampleRate, v);
+            slewLimiter[lane].setRiseFall(s, s);
+            v = slewLimiter[lane].process(dt > 0.f ? dt : getSamplePeriod(), v);
         }
 
         if (paramQuantity) {
@@ -482,12 +845,14 @@ struct ReMoveModule : MapModuleBase<1> {
         }
         switch (outCvMode) {
             case OUTCVMODE_CV_UNI:
-                outputs[CV_OUTPUT].setVoltage(rescale(v, 0.f, 1.f, 0.f, 10.f));
+                outputs[CV_OUTPUT].setVoltage(rescale(v, 0.f, 1.f, 0.f, 10.f), lane);
                 break;
             case OUTCVMODE_CV_BI:
-                outputs[CV_OUTPUT].setVoltage(rescale(v, 0.f, 1.f, -5.f, 5.f));
+                outputs[CV_OUTPUT].setVoltage(rescale(v, 0.f, 1.f, -5.f, 5.f), lane);
                 break;
             case OUTCVMODE_EOC:
+                // The end of the sequence is shared by all lanes
+                if (lane > 0) break;
                 if (dataPtr == seqLow + seqLength[seq] && playDir == REMOVE_PLAYDIR_FWD) {
                     switch (playMode) {
                         case PLAYMODE_LOOP:
@@ -522,19 +887,34 @@ struct ReMoveModule : MapModuleBase<1> {
 
         seqLength[seq] = 0;
         dataPtr = seqLow;
+        recWrapped = false;
+        seqHead[seq] = 0;
         sampleTimer.reset();
-        if (!inputs[CV_INPUT].isConnected()) paramHandles[0].color = nvgRGB(0xff, 0x40, 0xff);
-        recTouch = getValue();
+        for (int i = 0; i < laneCount; i++) {
+            if (!inputs[CV_INPUT].isConnected()) paramHandles[i].color = nvgRGB(0xff, 0x40, 0xff);
+            recTouch[i] = getValue(i);
+            pointCount[i][seq] = 0;
+            pointCursor[i] = 0;
+            pointCompressor[i].reset();
+        }
         recTouched = false;
     }
 
     void stopRecording() {
         isRecording = false;
+        recordFlush();
+        if (recWrapped) {
+            // The oldest sample is found at the current position, playback starts there
+            seqHead[seq] = dataPtr - seqLow;
+            recWrapped = false;
+        }
         if (dataPtr != seqLow) recOutCvPulse.trigger();
         dataPtr = seqLow;
         sampleTimer.reset();
-        paramHandles[0].color = nvgRGB(0x40, 0xff, 0xff);
-        valueFilters[0].reset();
+        for (int i = 0; i < laneCount; i++) {
+            paramHandles[i].color = nvgRGB(0x40, 0xff, 0xff);
+            valueFilters[i].reset();
+        }
 
         if (recChangeHistory) {
             recChangeHistory->newModuleJ = toJson();
@@ -581,12 +961,17 @@ struct ReMoveModule : MapModuleBase<1> {
         seq = 0;
         seqCount = c;
         dataPtr = 0;
-        for (int i = 0; i < REMOVE_MAX_SEQ; i++) seqLength[i] = 0;
+        for (int i = 0; i < REMOVE_MAX_SEQ; i++) seqLength[i] = seqHead[i] = 0;
+        for (int i = 0; i < REMOVE_MAX_LANES; i++) {
+            for (int j = 0; j < REMOVE_MAX_SEQ; j++) pointCount[i][j] = 0;
+            pointCursor[i] = 0;
+        }
         seqUpdate();
     }
 
     inline void seqUpdate() {
-        int s = REMOVE_MAX_DATA / seqCount;
+        int offset = std::max(dataPtr - seqLow, 0);
+        int s = laneSize / seqCount;
         seqLow = seq * s;
         seqHigh =  (seq + 1) * s;
         switch (seqChangeMode) {
@@ -594,55 +979,258 @@ struct ReMoveModule : MapModuleBase<1> {
                 dataPtr = seqLow;
                 playDir = REMOVE_PLAYDIR_FWD;
                 sampleTimer.reset();
-                valueFilters[0].reset();
+                for (int i = 0; i < laneCount; i++) {
+                    valueFilters[i].reset();
+                }
                 break;
             case SEQCHANGEMODE_OFFSET:
-                dataPtr = seqLength[seq] > 0 ? seqLow + (dataPtr % s) % seqLength[seq] : seqLow;
+                dataPtr = seqLength[seq] > 0 ? seqLow + offset % seqLength[seq] : seqLow;
                 break;
         }
     }
 
+    /**
+     * Changes how recorded data is stored, clears all recorded sequences.
+     */
+    void storageResize(STORAGEMODE mode) {
+        if (isRecording) return;
+        storageMode = mode;
+        seqResize(seqCount);
+    }
+
+    /**
+     * Changes the size of the recording buffer, clears all recorded sequences.
+     * The new buffer is swapped in by the engine thread.
+     */
+    void dataResize(int size) {
+        if (isRecording || seqDataNext.load(std::memory_order_acquire) || size == dataSize) return;
+        seqDataNextSize = size;
+        seqDataNext.store(bufferPool().acquire(size), std::memory_order_release);
+    }
+
+    /**
+     * Restores the recorder state loaded by dataFromJson, must be called on the GUI thread.
+     * A buffer of a different size and the number of lanes are handed to the engine first,
+     * the recorded data is restored on a later call after the engine has applied them.
+     */
+    void dataLoad() {
+        if (!recNextJ || seqDataNext.load(std::memory_order_acquire) || laneCountNext.load(std::memory_order_acquire) > 0) return;
+        json_t *rec0J = json_array_get(recNextJ, 0);
+        json_t *dataSizeJ = json_object_get(rec0J, "dataSize");
+        int size = dataSizeJ ? clamp((int)json_integer_value(dataSizeJ), REMOVE_MAX_DATA, REMOVE_MAX_DATA * 64) : REMOVE_MAX_DATA;
+        if (size != dataSize) {
+            dataResize(size);
+            return;
+        }
+        json_t *laneCountJ = json_object_get(rec0J, "laneCount");
+        int c = laneCountJ ? clamp((int)json_integer_value(laneCountJ), 1, REMOVE_MAX_LANES) : 1;
+        if (c != laneCount) {
+            laneCountNext.store(c, std::memory_order_release);
+            return;
+        }
+        recorderFromJson(rec0J);
+        json_decref(recNextJ);
+        recNextJ = NULL;
+    }
+
+    /** Returns a buffer swapped out by the engine to the pool, must be called on the GUI thread */
+    void dataRelease() {
+        float* old = seqDataOld.load(std::memory_order_acquire);
+        if (!old) return;
+        bufferPool().release(old, seqDataOldSize);
+        seqDataOld.store(NULL, std::memory_order_release);
+    }
+
+    /**
+     * Changes the number of lanes, the buffer is split evenly between all lanes.
+     * Clears all recorded sequences and the mappings of removed lanes.
+     * The new number of lanes is applied by the engine thread.
+     */
+    void laneResize(int c) {
+        if (isRecording) return;
+        for (int i = c; i < laneCount; i++) {
+            MapModuleBase::clearMap(i);
+        }
+        laneCountNext.store(c);
+    }
+
 
     void clearMap(int id) override {
-        onReset();
+        if (laneCount == 1) onReset();
         MapModuleBase::clearMap(id);
     }
 
     void enableLearn(int id) override {
         if (isRecording) return;
+        if (id >= laneCount) return;
         MapModuleBase::enableLearn(id);
     }
 
-    json_t *dataToJson() override {
-        json_t *rootJ = MapModuleBase::dataToJson();
-        json_object_set_new(rootJ, "panelTheme", json_integer(panelTheme));
+    void commitLearn() override {
+        MapModuleBase::commitLearn();
+        if (learningId >= laneCount) learningId = -1;
+    }
 
-        json_t *rec0J = json_object();
+    void updateMapLen() override {
+        MapModuleBase::updateMapLen();
+        mapLen = std::min(mapLen, laneCount);
+    }
 
-        int s = REMOVE_MAX_DATA / seqCount;
+    json_t *seqDataToJson(int lane) {
+        float* data = laneData(lane);
+        int s = laneSize / seqCount;
         json_t *seqDataJ = json_array();
         for (int i = 0; i < seqCount; i++) {
-            json_t *seqData1J = json_array();
+            // Sequences recorded wrapped are stored starting at the oldest sample
+            const float* v0 = &data[i * s];
+            std::vector<float> r;
+            if (seqHead[i] > 0) {
+                r.resize(seqLength[i]);
+                for (int j = 0; j < seqLength[i]; j++) r[j] = v0[(seqHead[i] + j) % s];
+                v0 = r.data();
+            }
+            std::string d;
+            if (dataBits == 16) {
+                std::vector<uint16_t> v(seqLength[i]);
+                for (int j = 0; j < seqLength[i]; j++) {
+                    v[j] = (uint16_t)std::round(clamp(v0[j], 0.f, 1.f) * 65535.f);
+                }
+                d = string::toBase64((const uint8_t*)v.data(), v.size() * sizeof(uint16_t));
+            }
+            else {
+                d = string::toBase64((const uint8_t*)v0, seqLength[i] * sizeof(float));
+            }
+            json_array_append_new(seqDataJ, json_string(d.c_str()));
+        }
+        return seqDataJ;
+    }
+
+    void seqDataFromJson(int lane, json_t *seqDataJ, int bits) {
+        float* data = laneData(lane);
+        int s = laneSize / seqCount;
+        json_t *seqData1J, *d;
+        size_t i;
+        json_array_foreach(seqDataJ, i, seqData1J) {
+            if ((int)i >= seqCount) continue;
+            if (json_is_string(seqData1J)) {
+                // Packed as 32-bit floats or 16-bit integers
+                std::vector<uint8_t> b;
+                try {
+                    b = string::fromBase64(json_string_value(seqData1J));
+                }
+                catch (std::exception& e) {
+                    WARN("Invalid recorded data in sequence #%i of lane #%i", (int)i + 1, lane + 1);
+                    seqLength[i] = 0;
+                    continue;
+                }
+                int n;
+                if (bits == 16) {
+                    n = std::min((int)(b.size() / sizeof(uint16_t)), s);
+                    const uint16_t* v = (const uint16_t*)b.data();
+                    for (int j = 0; j < n; j++) data[i * s + j] = v[j] / 65535.f;
+                }
+                else {
+                    n = std::min((int)(b.size() / sizeof(float)), s);
+                    std::memcpy(&data[i * s], b.data(), n * sizeof(float));
+                }
+                // Truncated data must not play values left over in the buffer
+                seqLength[i] = std::min(seqLength[i], n);
+                continue;
+            }
+            // Legacy format: array of reals, after two same values the number of repetitions follows
+            size_t j;
             float last1 = 100.f, last2 = -100.f;
-            for (int j = 0; j < seqLength[i]; j++) {
+            int c = 0;
+            json_array_foreach(seqData1J, j, d) {
+                if (c > seqLength[i]) continue;
                 if (last1 == last2) {
-                    // 2 times same value -> compress!
-                    int c = 0;
-                    while (seqData[i * s + j] == last1 && j < seqLength[i]) { c++; j++; }
-                    json_array_append_new(seqData1J, json_integer(c));
-                    if (j < seqLength[i]) json_array_append_new(seqData1J, json_real(seqData[i * s + j]));
-                    last2 = -100.f;
-                    last1 = seqData[i * s + j];
-                } 
+                    // we've seen two same values -> decompress!
+                    int v = json_integer_value(d);
+                    for (int k = 0; k < v; k++) { data[i * s + c] = last1; c++; }
+                    last1 = 100.f; last2 = -100.f;
+                }
                 else {
-                    json_array_append_new(seqData1J, json_real(seqData[i * s + j]));
+                    data[i * s + c] = json_real_value(d);
                     last2 = last1;
-                    last1 = seqData[i * s + j];
+                    last1 = data[i * s + c];
+                    c++;
                 }
             }
-            json_array_append_new(seqDataJ, seqData1J);
         }
-        json_object_set_new(rec0J, "seqData", seqDataJ);
+    }
+
+    json_t *seqPointsToJson(int lane) {
+        int s = laneSize / seqCount;
+        json_t *seqPointsJ = json_array();
+        for (int i = 0; i < seqCount; i++) {
+            // Packed as pairs of 32-bit floats for time and value
+            float* points = &laneData(lane)[i * s];
+            std::string d = string::toBase64((const uint8_t*)points, 2 * pointCount[lane][i] * sizeof(float));
+            json_array_append_new(seqPointsJ, json_string(d.c_str()));
+        }
+        return seqPointsJ;
+    }
+
+    void seqPointsFromJson(int lane, json_t *seqPointsJ) {
+        int s = laneSize / seqCount;
+        json_t *seqPoints1J;
+        size_t i;
+        json_array_foreach(seqPointsJ, i, seqPoints1J) {
+            if ((int)i >= seqCount) continue;
+            pointCount[lane][i] = 0;
+            if (json_is_string(seqPoints1J)) {
+                std::vector<uint8_t> b;
+                try {
+                    b = string::fromBase64(json_string_value(seqPoints1J));
+                }
+                catch (std::exception& e) {
+                    WARN("Invalid breakpoints in sequence #%i of lane #%i", (int)i + 1, lane + 1);
+                    seqLength[i] = 0;
+                    continue;
+                }
+                int n = std::min((int)(b.size() / (2 * sizeof(float))), s / 2);
+                std::memcpy(&laneData(lane)[i * s], b.data(), 2 * n * sizeof(float));
+                pointCount[lane][i] = n;
+                continue;
+            }
+            // Legacy format: array of integer times and real values
+            int n = std::min((int)json_array_size(seqPoints1J) / 2, s / 2);
+            for (int j = 0; j < n; j++) {
+                float t = json_integer_value(json_array_get(seqPoints1J, 2 * j));
+                float v = json_real_value(json_array_get(seqPoints1J, 2 * j + 1));
+                pushPoint(lane, i, t, v);
+            }
+        }
+    }
+
+    json_t *dataToJson() override {
+        json_t *rootJ = MapModuleBase::dataToJson();
+        json_object_set_new(rootJ, "panelTheme", json_integer(panelTheme));
+
+        if (recNextJ) {
+            // Not restored yet, keep the loaded state
+            json_object_set(rootJ, "recorder", recNextJ);
+            return rootJ;
+        }
+
+        json_t *rec0J = json_object();
+
+        if (storageMode == STORAGEMODE_SAMPLES) {
+            // Values are stored packed instead of one JSON node per sample
+            json_t *lanePackedJ = json_array();
+            for (int i = 0; i < laneCount; i++) {
+                json_array_append_new(lanePackedJ, seqDataToJson(i));
+            }
+            json_object_set_new(rec0J, "lanePacked", lanePackedJ);
+            json_object_set_new(rec0J, "dataBits", json_integer(dataBits));
+        }
+        else {
+            json_t *lanePointsJ = json_array();
+            for (int i = 0; i < laneCount; i++) {
+                json_array_append_new(lanePointsJ, seqPointsToJson(i));
+            }
+            json_object_set_new(rec0J, "lanePoints", lanePointsJ);
+        }
 
         json_t *seqLengthJ = json_array();
         for (int i = 0; i < seqCount; i++) {
@@ -650,6 +1238,9 @@ struct ReMoveModule : MapModuleBase<1> {
         }
         json_object_set_new(rec0J, "seqLength", seqLengthJ);
 
+        json_object_set_new(rec0J, "dataSize", json_integer(dataSize));
+        json_object_set_new(rec0J, "storageMode", json_integer(storageMode));
+        json_object_set_new(rec0J, "laneCount", json_integer(laneCount));
         json_object_set_new(rec0J, "seqCount", json_integer(seqCount));
         json_object_set_new(rec0J, "seq", json_integer(seq));
         json_object_set_new(rec0J, "seqCvMode", json_integer(seqCvMode));
@@ -662,6 +1253,8 @@ struct ReMoveModule : MapModuleBase<1> {
         json_object_set_new(rec0J, "recAutoplay", json_boolean(recAutoplay));
         json_object_set_new(rec0J, "playMode", json_integer(playMode));
         json_object_set_new(rec0J, "sampleRate", json_real(sampleRate));
+        json_object_set_new(rec0J, "audioRate", json_boolean(audioRate));
+        json_object_set_new(rec0J, "interpolate", json_boolean(interpolate));
         json_object_set_new(rec0J, "isPlaying", json_boolean(isPlaying));
 
         json_t *recJ = json_array();
@@ -672,12 +1265,21 @@ struct ReMoveModule : MapModuleBase<1> {
     }
 
     void dataFromJson(json_t *rootJ) override {
+        json_t *recJ = json_object_get(rootJ, "recorder");
+
         MapModuleBase::dataFromJson(rootJ);
         panelTheme = json_integer_value(json_object_get(rootJ, "panelTheme"));
 
-        json_t *recJ = json_object_get(rootJ, "recorder");
-        json_t *rec0J = json_array_get(recJ, 0);
+        // The engine keeps using buffer and lanes until it has applied the stored ones
+        if (recNextJ) json_decref(recNextJ);
+        recNextJ = recJ ? json_incref(recJ) : json_array();
+        dataLoad();
+    }
 
+    /** Restores the recorded data, buffer size and number of lanes must match the stored ones */
+    void recorderFromJson(json_t *rec0J) {
+        json_t *storageModeJ = json_object_get(rec0J, "storageMode");
+        storageMode = storageModeJ ? (STORAGEMODE)json_integer_value(storageModeJ) : STORAGEMODE_SAMPLES;
         json_t *seqCountJ = json_object_get(rec0J, "seqCount");
         if (seqCountJ) seqCount = json_integer_value(seqCountJ);
         json_t *seqJ = json_object_get(rec0J, "seq");
@@ -702,6 +1304,10 @@ struct ReMoveModule : MapModuleBase<1> {
         if (playModeJ) playMode = (PLAYMODE)json_integer_value(playModeJ);
         json_t *sampleRateJ = json_object_get(rec0J, "sampleRate");
         if (sampleRateJ) sampleRate = json_real_value(sampleRateJ);
+        json_t *audioRateJ = json_object_get(rec0J, "audioRate");
+        audioRate = audioRateJ ? json_boolean_value(audioRateJ) : false;
+        json_t *interpolateJ = json_object_get(rec0J, "interpolate");
+        interpolate = interpolateJ ? json_boolean_value(interpolateJ) : false;
         json_t *isPlayingJ = json_object_get(rec0J, "isPlaying");
         if (isPlayingJ) isPlaying = json_boolean_value(isPlayingJ);
 
@@ -715,31 +1321,42 @@ struct ReMoveModule : MapModuleBase<1> {
             }
         }
 
-        int s = REMOVE_MAX_DATA / seqCount;
+        json_t *dataBitsJ = json_object_get(rec0J, "dataBits");
+        dataBits = dataBitsJ ? json_integer_value(dataBitsJ) : 32;
+        json_t *lanePackedJ = json_object_get(rec0J, "lanePacked");
+        if (lanePackedJ) {
+            json_t *d;
+            size_t i;
+            json_array_foreach(lanePackedJ, i, d) {
+                if ((int)i >= laneCount) continue;
+                seqDataFromJson(i, d, dataBits);
+            }
+        }
+        // Legacy format: first lane in "seqData", further lanes in "laneData"
         json_t *seqDataJ = json_object_get(rec0J, "seqData");
-        if (seqDataJ) {
-            json_t *seqData1J, *d;
+        if (seqDataJ) seqDataFromJson(0, seqDataJ, 32);
+        json_t *laneDataJ = json_object_get(rec0J, "laneData");
+        if (laneDataJ) {
+            json_t *d;
             size_t i;
-            json_array_foreach(seqDataJ, i, seqData1J) {
-                if ((int)i >= seqCount) continue;
-                size_t j;
-                float last1 = 100.f, last2 = -100.f;
-                int c = 0;
-                json_array_foreach(seqData1J, j, d) {
-                    if (c > seqLength[i]) continue;
-                    if (last1 == last2) {
-                        // we've seen two same values -> decompress!
-                        int v = json_integer_value(d);
-                        for (int k = 0; k < v; k++) { seqData[i * s + c] = last1; c++; }
-                        last1 = 100.f; last2 = -100.f;
-                    }
-                    else {
-                        seqData[i * s + c] = json_real_value(d);
-                        last2 = last1;
-                        last1 = seqData[i * s + c];
-                        c++;
-                    }
-                }
+            json_array_foreach(laneDataJ, i, d) {
+                if ((int)i + 1 >= laneCount) continue;
+                seqDataFromJson(i + 1, d, 32);
+            }
+        }
+        // Packed samples are always stored starting at the oldest sample
+        for (int i = 0; i < REMOVE_MAX_SEQ; i++) seqHead[i] = 0;
+        json_t *lanePointsJ = json_object_get(rec0J, "lanePoints");
+        for (int i = 0; i < REMOVE_MAX_LANES; i++) {
+            for (int j = 0; j < REMOVE_MAX_SEQ; j++) pointCount[i][j] = 0;
+            pointCursor[i] = 0;
+        }
+        if (lanePointsJ) {
+            json_t *d;
+            size_t i;
+            json_array_foreach(lanePointsJ, i, d) {
+                if ((int)i >= laneCount) continue;
+                seqPointsFromJson(i, d);
             }
         }
 
@@ -755,26 +1372,41 @@ struct ReMoveModule : MapModuleBase<1> {
         dsp::ExponentialFilter filter;
         filter.setLambda(sampleRate * 10.f);
 
-        int s = REMOVE_MAX_DATA / seqCount;
+        int s = laneSize / seqCount;
         // Generate maximum of 4 seconds random data
         int l = std::min((int)round(1.f / sampleRate * 8.f), s);
 
-        for (int i = 0; i < seqCount; i++) {
-            // Set some start-value for the exponential filter
-            filter.out = 0.5f + d(gen) * 10.f;
-            float dir = 1.f;
-            float p = 0.5f;
-            for (int c = 0; c < l; c++) {
-                // Reduce the number of direction changes, only when rand > 0
-                if (c % (l / 8) == 0) dir = d(gen) >= 0 ? 1 : -1;
-                float r = d(gen);
-                // Inject some static in the curve
-                p = filter.process(1.f, r >= 0.005f ? p + dir * abs(r) : p);
-                // Only range [0,1] is valid
-                p = clamp(p, 0.f, 1.f);
-                seqData[i * s + c] = p;
+        for (int k = 0; k < laneCount; k++) {
+            float* data = laneData(k);
+            for (int i = 0; i < seqCount; i++) {
+                pointCount[k][i] = 0;
+                seqHead[i] = 0;
+                // Set some start-value for the exponential filter
+                filter.out = 0.5f + d(gen) * 10.f;
+                float dir = 1.f;
+                float p = 0.5f;
+                for (int c = 0; c < l; c++) {
+                    // Reduce the number of direction changes, only when rand > 0
+                    if (c % (l / 8) == 0) dir = d(gen) >= 0 ? 1 : -1;
+                    float r = d(gen);
+                    // Inject some static in the curve
+                    p = filter.process(1.f, r >= 0.005f ? p + dir * abs(r) : p);
+                    // Only range [0,1] is valid
+                    p = clamp(p, 0.f, 1.f);
+                    if (storageMode == STORAGEMODE_SAMPLES) {
+                        data[i * s + c] = p;
+                    }
+                    else {
+                        float ot, ov;
+                        if (pointCompressor[k].process(c, p, ot, ov)) pushPoint(k, i, ot, ov);
+                    }
+                }
+                if (storageMode == STORAGEMODE_POINTS) {
+                    float ot, ov;
+                    if (pointCompressor[k].flush(ot, ov)) pushPoint(k, i, ot, ov);
+                }
+                seqLength[i] = l;
             }
-            seqLength[i] = l;
         }
     }
 };
@@ -804,13 +1436,20 @@ struct ReMoveDisplay : TransparentWidget {
         int seqPos = module->dataPtr - module->seqLow;
 
         if (module->isRecording) {
-            // Draw text showing remaining time
-            float t = ((float)REMOVE_MAX_DATA / (float)module->seqCount - (float)seqPos) * module->sampleRate;
+            // Draw text showing remaining time, or elapsed time for breakpoints
+            std::string text;
+            if (module->storageMode == STORAGEMODE_SAMPLES) {
+                float t = ((float)module->laneSize / (float)module->seqCount - (float)seqPos) * module->getSamplePeriod();
+                text = string::f("REC -%.1fs", t);
+            }
+            else {
+                text = string::f("REC %.1fs", (float)seqPos * module->getSamplePeriod());
+            }
             nvgFontSize(vg, 11);
             nvgFontFaceId(vg, font->handle);
             nvgTextLetterSpacing(vg, -2.2);
             nvgFillColor(vg, nvgRGBA(0x66, 0x66, 0x66, 0xff));
-            nvgTextBox(vg, 6, box.size.y - 4, 120, string::f("REC -%.1fs", t).c_str(), NULL);
+            nvgTextBox(vg, 6, box.size.y - 4, 120, text.c_str(), NULL);
         }
 
         int seqLength = module->seqLength[module->seq];
@@ -827,29 +1466,32 @@ struct ReMoveDisplay : TransparentWidget {
             nvgStroke(vg);
         }
 
-        // Draw automation-line
-        nvgStrokeColor(vg, nvgRGB(0xd8, 0xd8, 0xd8));
+        // Draw automation-lines, the first lane brightest
         nvgSave(vg);
         Rect b = Rect(Vec(0, 2), Vec(maxX, maxY - 4));
         nvgScissor(vg, b.pos.x, b.pos.y, b.size.x, b.size.y);
-        nvgBeginPath(vg);
-        int c = std::min(seqLength, 120);
-        for (int i = 0; i < c; i++) {
-            float x = (float)i / (c - 1);
-            float y = module->seqData[module->seqLow + (int)floor(x * (seqLength - 1))] * 0.96f + 0.02f;
-            float px = b.pos.x + b.size.x * x;
-            float py = b.pos.y + b.size.y * (1.0 - y);
-            if (i == 0)
-                nvgMoveTo(vg, px, py);
-            else
-                nvgLineTo(vg, px, py);
-        }
-
         nvgLineCap(vg, NVG_ROUND);
         nvgMiterLimit(vg, 2.0);
         nvgStrokeWidth(vg, 1.0);
         nvgGlobalCompositeOperation(vg, NVG_LIGHTER);
-        nvgStroke(vg);
+        int c = std::min(seqLength, 120);
+        for (int k = module->laneCount - 1; k >= 0; k--) {
+            // The display uses its own cursor as it runs on a different thread than playback
+            int cursor = 0;
+            nvgStrokeColor(vg, k == 0 ? nvgRGB(0xd8, 0xd8, 0xd8) : nvgRGB(0x60, 0x60, 0x60));
+            nvgBeginPath(vg);
+            for (int i = 0; i < c; i++) {
+                float x = (float)i / (c - 1);
+                float y = module->value(k, module->seqLow + (int)floor(x * (seqLength - 1)), cursor) * 0.96f + 0.02f;
+                float px = b.pos.x + b.size.x * x;
+                float py = b.pos.y + b.size.y * (1.0 - y);
+                if (i == 0)
+                    nvgMoveTo(vg, px, py);
+                else
+                    nvgLineTo(vg, px, py);
+            }
+            nvgStroke(vg);
+        }
         nvgResetScissor(vg);
         nvgRestore(vg);
     }
@@ -983,12 +1625,29 @@ struct SampleRateMenuItem : MenuItem {
         void onAction(const event::Action &e) override {
             if (module->isRecording) return;
             module->sampleRate = sampleRate;
+            module->audioRate = false;
         }
 
         void step() override {
-            int s1 = REMOVE_MAX_DATA * sampleRate;
+            int s1 = module->laneSize * sampleRate;
             int s2 = s1 / module->seqCount;
-            rightText = string::f(((module->sampleRate == sampleRate) ? "✔ %ds / %ds" : "%ds / %ds"), s1, s2);
+            rightText = string::f(((!module->audioRate && module->sampleRate == sampleRate) ? "✔ %ds / %ds" : "%ds / %ds"), s1, s2);
+            MenuItem::step();
+        }
+    };
+
+    struct AudioRateItem : MenuItem {
+        ReMoveModule *module;
+
+        void onAction(const event::Action &e) override {
+            if (module->isRecording) return;
+            module->audioRate = true;
+        }
+
+        void step() override {
+            float s1 = module->laneSize * APP->engine->getSampleTime();
+            float s2 = s1 / module->seqCount;
+            rightText = string::f((module->audioRate ? "✔ %.1fs / %.1fs" : "%.1fs / %.1fs"), s1, s2);
             MenuItem::step();
         }
     };
@@ -1004,6 +1663,7 @@ struct SampleRateMenuItem : MenuItem {
         menu->addChild(construct<SampleRateItem>(&MenuItem::text, "500Hz", &SampleRateItem::module, module, &SampleRateItem::sampleRate, 1.f/500.f));
         menu->addChild(construct<SampleRateItem>(&MenuItem::text, "1000Hz", &SampleRateItem::module, module, &SampleRateItem::sampleRate, 1.f/1000.f));
         menu->addChild(construct<SampleRateItem>(&MenuItem::text, "2000Hz", &SampleRateItem::module, module, &SampleRateItem::sampleRate, 1.f/2000.f));
+        menu->addChild(construct<AudioRateItem>(&MenuItem::text, "Audio rate", &AudioRateItem::module, module));
         return menu;
     }
 };
@@ -1037,6 +1697,127 @@ struct SeqCountMenuItem : MenuItem {
 };
 
 
+struct DataSizeMenuItem : MenuItem {
+    struct DataSizeItem : MenuItem {
+        ReMoveModule *module;
+        int dataSize;
+
+        void onAction(const event::Action &e) override {
+            if (module->isRecording) return;
+            module->dataResize(dataSize);
+        }
+
+        void step() override {
+            rightText = (module->dataSize == dataSize) ? "✔" : "";
+            MenuItem::step();
+        }
+    };
+    
+    ReMoveModule *module;
+    Menu *createChildMenu() override {
+        Menu *menu = new Menu;
+        std::vector<std::string> names = {"64k", "256k", "1M", "4M"};
+        for (size_t i = 0; i < names.size(); i++) {
+            menu->addChild(construct<DataSizeItem>(&MenuItem::text, names[i] + " samples", &DataSizeItem::module, module, &DataSizeItem::dataSize, REMOVE_MAX_DATA << (2 * i)));
+        }
+        return menu;
+    }
+};
+
+
+struct DataBitsMenuItem : MenuItem {
+    struct DataBitsItem : MenuItem {
+        ReMoveModule *module;
+        int dataBits;
+
+        void onAction(const event::Action &e) override {
+            module->dataBits = dataBits;
+        }
+
+        void step() override {
+            rightText = module->dataBits == dataBits ? "✔" : "";
+            MenuItem::step();
+        }
+    };
+    
+    ReMoveModule *module;
+    Menu *createChildMenu() override {
+        Menu *menu = new Menu;
+        menu->addChild(construct<DataBitsItem>(&MenuItem::text, "32-bit float (lossless)", &DataBitsItem::module, module, &DataBitsItem::dataBits, 32));
+        menu->addChild(construct<DataBitsItem>(&MenuItem::text, "16-bit (half size)", &DataBitsItem::module, module, &DataBitsItem::dataBits, 16));
+        return menu;
+    }
+};
+
+
+struct InterpolateItem : MenuItem {
+    ReMoveModule *module;
+
+    void onAction(const event::Action &e) override {
+        module->interpolate ^= true;
+    }
+
+    void step() override {
+        rightText = module->interpolate ? "✔" : "";
+        MenuItem::step();
+    }
+};
+
+
+struct StorageModeMenuItem : MenuItem {
+    struct StorageModeItem : MenuItem {
+        ReMoveModule *module;
+        STORAGEMODE storageMode;
+
+        void onAction(const event::Action &e) override {
+            if (module->isRecording || module->storageMode == storageMode) return;
+            module->storageResize(storageMode);
+        }
+
+        void step() override {
+            rightText = module->storageMode == storageMode ? "✔" : "";
+            MenuItem::step();
+        }
+    };
+    
+    ReMoveModule *module;
+    Menu *createChildMenu() override {
+        Menu *menu = new Menu;
+        menu->addChild(construct<StorageModeItem>(&MenuItem::text, "Every sample", &StorageModeItem::module, module, &StorageModeItem::storageMode, STORAGEMODE_SAMPLES));
+        menu->addChild(construct<StorageModeItem>(&MenuItem::text, "Breakpoints (compressed)", &StorageModeItem::module, module, &StorageModeItem::storageMode, STORAGEMODE_POINTS));
+        return menu;
+    }
+};
+
+
+struct LaneCountMenuItem : MenuItem {
+    struct LaneCountItem : MenuItem {
+        ReMoveModule *module;
+        int laneCount;
+
+        void onAction(const event::Action &e) override {
+            if (module->isRecording) return;
+            module->laneResize(laneCount);
+        }
+
+        void step() override {
+            rightText = (module->laneCount == laneCount) ? "✔" : "";
+            MenuItem::step();
+        }
+    };
+    
+    ReMoveModule *module;
+    Menu *createChildMenu() override {
+        Menu *menu = new Menu;
+        std::vector<std::string> names = {"1", "2", "4", "8"};
+        for (size_t i = 0; i < names.size(); i++) {
+            menu->addChild(construct<LaneCountItem>(&MenuItem::text, names[i], &LaneCountItem::module, module, &LaneCountItem::laneCount, (int)pow(2, i)));
+        }
+        return menu;
+    }
+};
+
+
 struct SeqChangeModeMenuItem : MenuItem {
     struct SeqChangeModeItem : MenuItem {
         ReMoveModule *module;
@@ -1187,6 +1968,9 @@ struct RecLight : RedLight {
 
 
 struct ReMoveWidget : ThemedModuleWidget<ReMoveModule> {
+    /** widget being dragged on last step */
+    Widget *touchWidget = NULL;
+
     ReMoveWidget(ReMoveModule *module)
         : ThemedModuleWidget<ReMoveModule>(module, "ReMove") {
         setModule(module);
@@ -1226,7 +2010,7 @@ struct ReMoveWidget : ThemedModuleWidget<ReMoveModule> {
         addParam(createParamCentered<StoermelderTrimpot>(Vec(45.0f, 187.2f), module, ReMoveModule::SLEW_PARAM));
         addInput(createInputCentered<StoermelderPort>(Vec(68.7f, 200.1f), module, ReMoveModule::PHASE_INPUT));
 
-        MapModuleDisplay<1, ReMoveModule> *mapWidget = createWidget<MapModuleDisplay<1, ReMoveModule>>(Vec(6.8f, 36.4f));
+        MapModuleDisplay<REMOVE_MAX_LANES, ReMoveModule> *mapWidget = createWidget<MapModuleDisplay<REMOVE_MAX_LANES, ReMoveModule>>(Vec(6.8f, 36.4f));
         mapWidget->box.size = Vec(76.2f, 23.f);
         mapWidget->setModule(module);
         addChild(mapWidget);
@@ -1238,6 +2022,29 @@ struct ReMoveWidget : ThemedModuleWidget<ReMoveModule> {
         addChild(display); 
     }
 
+    void step() override {
+        ThemedModuleWidget<ReMoveModule>::step();
+        if (module) {
+            ReMoveModule *module = dynamic_cast<ReMoveModule*>(this->module);
+            module->dataRelease();
+            module->dataLoad();
+
+            // Report drags to the module, detected once per frame so start and end of a
+            // touch-recording are only as accurate as the GUI frame rate
+            Widget *w = APP->event->getDraggedWidget();
+            if (w != touchWidget && module->touchQueue.capacity() >= 2) {
+                if (touchWidget) {
+                    module->touchQueue.push(TOUCHEVENT_RELEASE);
+                }
+                if (w) {
+                    ParamWidget *pw = dynamic_cast<ParamWidget*>(w);
+                    module->touchQueue.push(pw && module->isLaneParam(pw->paramQuantity) ? TOUCHEVENT_PARAM : TOUCHEVENT_DRAG);
+                }
+                touchWidget = w;
+            }
+        }
+    }
+
     void appendContextMenu(Menu *menu) override {
         ThemedModuleWidget<ReMoveModule>::appendContextMenu(menu);
         ReMoveModule *module = dynamic_cast<ReMoveModule*>(this->module);
@@ -1253,6 +2060,22 @@ struct ReMoveWidget : ThemedModuleWidget<ReMoveModule> {
         seqCountMenuItem->rightText = RIGHT_ARROW;
         menu->addChild(seqCountMenuItem);
 
+        LaneCountMenuItem *laneCountMenuItem = construct<LaneCountMenuItem>(&MenuItem::text, "# of lanes", &LaneCountMenuItem::module, module);
+        laneCountMenuItem->rightText = RIGHT_ARROW;
+        menu->addChild(laneCountMenuItem);
+
+        StorageModeMenuItem *storageModeMenuItem = construct<StorageModeMenuItem>(&MenuItem::text, "Storage", &StorageModeMenuItem::module, module);
+        storageModeMenuItem->rightText = RIGHT_ARROW;
+        menu->addChild(storageModeMenuItem);
+
+        DataSizeMenuItem *dataSizeMenuItem = construct<DataSizeMenuItem>(&MenuItem::text, "Buffer size", &DataSizeMenuItem::module, module);
+        dataSizeMenuItem->rightText = RIGHT_ARROW;
+        menu->addChild(dataSizeMenuItem);
+
+        DataBitsMenuItem *dataBitsMenuItem = construct<DataBitsMenuItem>(&MenuItem::text, "Patch precision", &DataBitsMenuItem::module, module);
+        dataBitsMenuItem->rightText = RIGHT_ARROW;
+        menu->addChild(dataBitsMenuItem);
+
         SeqChangeModeMenuItem *seqChangeModeMenuItem = construct<SeqChangeModeMenuItem>(&MenuItem::text, "Sequence change mode", &SeqChangeModeMenuItem::module, module);
         seqChangeModeMenuItem->rightText = RIGHT_ARROW;
         menu->addChild(seqChangeModeMenuItem);
@@ -1269,6 +2092,8 @@ struct ReMoveWidget : ThemedModuleWidget<ReMoveModule> {
         playModeMenuItem->rightText = RIGHT_ARROW;
         menu->addChild(playModeMenuItem);
 
+        menu->addChild(construct<InterpolateItem>(&MenuItem::text, "Interpolate playback", &InterpolateItem::module, module));
+
         menu->addChild(new MenuSeparator());
 
         SeqCvModeMenuItem *seqCvModeMenuItem = construct<SeqCvModeMenuItem>(&MenuItem::text, "Port SEQ# mode", &SeqCvModeMenuItem::module, module);
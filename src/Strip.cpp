@@ -1,6 +1,7 @@
 #include "Strip.hpp"
 #include <thread>
 #include <mutex>
+#include <atomic>
 
 namespace StoermelderPackOne {
 namespace Strip {
@@ -50,6 +51,24 @@ struct StripModule : StripModuleBase {
 
 	bool lastState = false;
 
+	/** Modules of the current strip, rebuilt only if the expander chain changes */
+	std::vector<Module*> members;
+	std::vector<int> memberIds;
+	std::vector<ModuleWidget*> memberWidgets;
+	MODE membersMode = MODE::LEFTRIGHT;
+
+	/** Bypass or randomization of the strip, its undo entry is built by the widget on the GUI-thread */
+	struct HistoryRequest {
+		bool randomize;
+		bool bypass;
+		std::vector<int> moduleIds;
+	};
+	static const int HISTORY_QUEUE = 16;
+	/** Single-producer single-consumer ring, filled by the engine-thread and drained by the widget */
+	HistoryRequest historyQueue[HISTORY_QUEUE];
+	std::atomic<int> historyHead{0};
+	std::atomic<int> historyTail{0};
+
 	std::mutex excludeMutex;
 	bool excludeLearn = false;
 	/** [Stored to JSON] */ 
@@ -78,6 +97,12 @@ struct StripModule : StripModuleBase {
 		configParam(EXCLUDE_PARAM, 0, 1, 0, "Parameter randomization include/exclude");
 
 		lightDivider.setDivision(1024);
+		members.reserve(64);
+		memberIds.reserve(64);
+		memberWidgets.reserve(64);
+		for (int i = 0; i < HISTORY_QUEUE; i++) {
+			historyQueue[i].moduleIds.reserve(64);
+		}
 		onReset();
 	}
 
@@ -128,171 +153,147 @@ struct StripModule : StripModuleBase {
 		}
 	}
 
-	/** 
-	 * Disables/enables all modules of the current strip.
-	 * To be called from engine-thread only.
+	/**
+	 * Checks if the modules next to STRIP differ from the cached strip members.
+	 * Only follows the expander pointers, nothing is allocated.
 	 */
-	void groupDisable(bool val, bool useHistory) {
-		if (lastState == val) return;
-		lastState = val;
-
-		history::ComplexAction* complexAction;
-		if (useHistory) {
-			complexAction = new history::ComplexAction;
-			complexAction->name = "stoermelder STRIP bypass";
-			APP->history->push(complexAction);
-		}
-
+	bool membersChanged() {
+		if (membersMode != mode) return true;
+		size_t i = 0;
 		if (mode == MODE::LEFTRIGHT || mode == MODE::RIGHT) {
 			Module* m = this;
 			while (true) {
 				if (!m || m->rightExpander.moduleId < 0) break;
-				// This is what "Module.hpp" says about bypass:
-				// "Module subclasses should not read/write this variable."
-				m->rightExpander.module->bypass = val;
-				// Clear outputs and set to 1 channel
-				for (Output& output : m->rightExpander.module->outputs) {
-					// This zeros all voltages, but the channel is set to 1 if connected
-					output.setChannels(0);
-				}
-
-				if (useHistory) {
-					// history::ModuleBypass
-					history::ModuleBypass* h = new history::ModuleBypass;
-					h->moduleId = m->rightExpander.module->id;
-					h->bypass = m->rightExpander.module->bypass;
-					complexAction->push(h);
-				}
-
 				m = m->rightExpander.module;
+				if (i >= members.size() || members[i] != m || memberIds[i] != m->id) return true;
+				i++;
 			}
 		}
-
 		if (mode == MODE::LEFTRIGHT || mode == MODE::LEFT) {
 			Module* m = this;
 			while (true) {
 				if (!m || m->leftExpander.moduleId < 0) break;
-				// This is what "Module.hpp" says about bypass:
-				// "Module subclasses should not read/write this variable."
-				m->leftExpander.module->bypass = val;
-				// Clear outputs and set to 1 channel
-				for (Output& output : m->leftExpander.module->outputs) {
-					// This zeros all voltages, but the channel is set to 1 if connected
-					output.setChannels(0);
-				}
-
-				if (useHistory) {
-					// history::ModuleBypass
-					history::ModuleBypass* h = new history::ModuleBypass;
-					h->moduleId = m->leftExpander.module->id;
-					h->bypass = m->leftExpander.module->bypass;
-					complexAction->push(h);
-				}
-
 				m = m->leftExpander.module;
+				if (i >= members.size() || members[i] != m || memberIds[i] != m->id) return true;
+				i++;
 			}
 		}
+		return i != members.size();
 	}
 
-	/** 
-	 * Randomizes all modules of the current strip.
-	 * To be called from engine-thread only.
-	 */
-	void groupRandomize(bool useHistory) {
-		//std::lock_guard<std::mutex> lockGuard(excludeMutex);
-		// Do not lock the mutex as changes on excludedParams are rare events
-
-		history::ComplexAction* complexAction;
-		if (useHistory) {
-			complexAction = new history::ComplexAction;
-			complexAction->name = "stoermelder STRIP randomize";
-			APP->history->push(complexAction);
-		}
-
+	void membersUpdate() {
+		members.clear();
+		memberIds.clear();
+		memberWidgets.clear();
+		membersMode = mode;
 		if (mode == MODE::LEFTRIGHT || mode == MODE::RIGHT) {
 			Module* m = this;
 			while (true) {
 				if (!m || m->rightExpander.moduleId < 0) break;
-				// Be careful: this function is called from the dsp-thread, but widgets belong
-				// to the app-world!
-
-				history::ModuleChange* h;
-				if (useHistory) {
-					// history::ModuleChange
-					h = new history::ModuleChange;
-					h->moduleId = m->rightExpander.moduleId;
-					h->oldModuleJ = m->rightExpander.module->toJson();
-					complexAction->push(h);
-				}
-
-				ModuleWidget* mw = APP->scene->rack->getModule(m->rightExpander.moduleId);
-				for (ParamWidget* param : mw->params) {
-					switch (randomExcl) {
-						case RANDOMEXCL::NONE:
-							param->randomize();
-							break;
-						case RANDOMEXCL::EXC:
-							if (excludedParams.find(std::make_tuple(m->rightExpander.moduleId, param->paramQuantity->paramId)) == excludedParams.end())
-								param->randomize();
-							break;
-						case RANDOMEXCL::INC:
-							if (excludedParams.find(std::make_tuple(m->rightExpander.moduleId, param->paramQuantity->paramId)) != excludedParams.end())
-								param->randomize();
-							break;
-					}
-				}
-				if (!randomParamsOnly) {
-					mw->module->onRandomize();
-				}
-				if (useHistory) {
-					h->newModuleJ = m->rightExpander.module->toJson();
-				}
-
 				m = m->rightExpander.module;
+				if (!m) break;
+				members.push_back(m);
+				memberIds.push_back(m->id);
+				memberWidgets.push_back(APP->scene->rack->getModule(m->id));
 			}
 		}
 		if (mode == MODE::LEFTRIGHT || mode == MODE::LEFT) {
 			Module* m = this;
 			while (true) {
 				if (!m || m->leftExpander.moduleId < 0) break;
-				// Be careful: this function is called from the dsp-thread, but widgets belong
-				// to the app-world!
+				m = m->leftExpander.module;
+				if (!m) break;
+				members.push_back(m);
+				memberIds.push_back(m->id);
+				memberWidgets.push_back(APP->scene->rack->getModule(m->id));
+			}
+		}
+	}
 
-				history::ModuleChange* h;
-				if (useHistory) {
-					// history::ModuleChange
-					h = new history::ModuleChange;
-					h->moduleId = m->leftExpander.moduleId;
-					h->oldModuleJ = m->leftExpander.module->toJson();
-					complexAction->push(h);
-				}
+	/** 
+	 * Disables/enables all modules of the current strip.
+	 * To be called from engine-thread only.
+	 */
+	void groupDisable(bool val, bool useHistory) {
+		if (lastState == val) return;
+		lastState = val;
+		if (membersChanged()) membersUpdate();
+
+		for (Module* m : members) {
+			// This is what "Module.hpp" says about bypass:
+			// "Module subclasses should not read/write this variable."
+			m->bypass = val;
+			// Clear outputs and set to 1 channel
+			for (Output& output : m->outputs) {
+				// This zeros all voltages, but the channel is set to 1 if connected
+				output.setChannels(0);
+			}
+		}
 
-				ModuleWidget* mw = APP->scene->rack->getModule(m->leftExpander.moduleId);
-				for (ParamWidget* param : mw->params) {
-					switch (randomExcl) {
-						case RANDOMEXCL::NONE:
-							param->randomize();
-							break;
-						case RANDOMEXCL::EXC:
-							if (excludedParams.find(std::make_tuple(m->leftExpander.moduleId, param->paramQuantity->paramId)) == excludedParams.end())
-								param->randomize();
-							break;
-						case RANDOMEXCL::INC:
-							if (excludedParams.find(std::make_tuple(m->leftExpander.moduleId, param->paramQuantity->paramId)) != excludedParams.end())
-								param->randomize();
-							break;
-					}
-				}
-				if (!randomParamsOnly) {
-					mw->module->onRandomize();
-				}
-				if (useHistory) {
-					h->newModuleJ = m->leftExpander.module->toJson();
-				}
+		// If the GUI-thread lags behind the queue is full and the undo entry is skipped
+		if (useHistory) historyPush(false, val);
+	}
 
-				m = m->leftExpander.module;
+	/** 
+	 * Randomizes all modules of the current strip.
+	 * To be called from engine-thread only, randomization with history is handed
+	 * over to the GUI-thread.
+	 */
+	void groupRandomize(bool useHistory) {
+		if (membersChanged()) membersUpdate();
+
+		// If the queue is full the strip is randomized right away without undo entry
+		if (useHistory && historyPush(true, false)) return;
+
+		for (ModuleWidget* mw : memberWidgets) {
+			if (mw) moduleRandomize(mw);
+		}
+	}
+
+	/**
+	 * Queues an undo entry for the current strip members, returns false if the queue is full.
+	 * To be called from engine-thread only.
+	 */
+	bool historyPush(bool randomize, bool bypass) {
+		int head = historyHead.load(std::memory_order_relaxed);
+		int next = (head + 1) % HISTORY_QUEUE;
+		if (next == historyTail.load(std::memory_order_acquire)) return false;
+		HistoryRequest& r = historyQueue[head];
+		r.randomize = randomize;
+		r.bypass = bypass;
+		r.moduleIds.assign(memberIds.begin(), memberIds.end());
+		historyHead.store(next, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Randomizes a single module of the strip, respecting the excluded parameters.
+	 */
+	void moduleRandomize(ModuleWidget* mw) {
+		//std::lock_guard<std::mutex> lockGuard(excludeMutex);
+		// Do not lock the mutex as changes on excludedParams are rare events
+
+		// Be careful: this function is also called from the dsp-thread, but widgets belong
+		// to the app-world!
+		int moduleId = mw->module->id;
+		for (ParamWidget* param : mw->params) {
+			switch (randomExcl) {
+				case RANDOMEXCL::NONE:
+					param->randomize();
+					break;
+				case RANDOMEXCL::EXC:
+					if (excludedParams.find(std::make_tuple(moduleId, param->paramQuantity->paramId)) == excludedParams.end())
+						param->randomize();
+					break;
+				case RANDOMEXCL::INC:
+					if (excludedParams.find(std::make_tuple(moduleId, param->paramQuantity->paramId)) != excludedParams.end())
+						param->randomize();
+					break;
 			}
 		}
+		if (!randomParamsOnly) {
+			mw->module->onRandomize();
+		}
 	}
 
 	json_t* dataToJson() override {
@@ -626,6 +627,52 @@ struct StripWidget : StripWidgetBase<StripModule> {
 		addParam(button);
 	}
 
+	void step() override {
+		if (module) {
+			historyStep();
+		}
+		StripWidgetBase<StripModule>::step();
+	}
+
+	/**
+	 * Builds the undo entries for bypass and randomization requested by the engine-thread,
+	 * in the order they were requested.
+	 */
+	void historyStep() {
+		int tail = module->historyTail.load(std::memory_order_relaxed);
+		while (tail != module->historyHead.load(std::memory_order_acquire)) {
+			StripModule::HistoryRequest& r = module->historyQueue[tail];
+			history::ComplexAction* complexAction = new history::ComplexAction;
+			if (!r.randomize) {
+				complexAction->name = "stoermelder STRIP bypass";
+				for (int moduleId : r.moduleIds) {
+					// history::ModuleBypass
+					history::ModuleBypass* h = new history::ModuleBypass;
+					h->moduleId = moduleId;
+					h->bypass = r.bypass;
+					complexAction->push(h);
+				}
+			}
+			else {
+				complexAction->name = "stoermelder STRIP randomize";
+				for (int moduleId : r.moduleIds) {
+					ModuleWidget* mw = APP->scene->rack->getModule(moduleId);
+					if (!mw) continue;
+					// history::ModuleChange
+					history::ModuleChange* h = new history::ModuleChange;
+					h->moduleId = moduleId;
+					h->oldModuleJ = mw->module->toJson();
+					module->moduleRandomize(mw);
+					h->newModuleJ = mw->module->toJson();
+					complexAction->push(h);
+				}
+			}
+			APP->history->push(complexAction);
+			tail = (tail + 1) % StripModule::HISTORY_QUEUE;
+			module->historyTail.store(tail, std::memory_order_release);
+		}
+	}
+
 	void appendContextMenu(Menu* menu) override {
 		ThemedModuleWidget<StripModule>::appendContextMenu(menu);
 		StripModule* module = dynamic_cast<StripModule*>(this->module);
@@ -39,6 +39,178 @@ struct StripBayBase : Module {
 };
 
 
+/**
+ * In-memory representation of a module within a strip. Parameter values are kept in
+ * flat arrays, json is used only for the module's data.
+ */
+struct StripSnapshotModule {
+	std::string pluginSlug;
+	std::string modelSlug;
+	std::string version;
+	int id = -1;
+	bool bypass = false;
+	std::vector<int> paramIds;
+	std::vector<float> paramValues;
+	/** Owned by the snapshot, NULL if the module has no data */
+	json_t* dataJ = NULL;
+};
+
+struct StripSnapshotCable {
+	int outputModuleId;
+	int outputId;
+	int inputModuleId;
+	int inputId;
+	std::string color;
+};
+
+/**
+ * In-memory representation of a strip. Can be handed over by pointer, loading from a
+ * snapshot sets the parameters directly instead of a json round-trip of every module.
+ */
+struct StripSnapshot {
+	std::vector<StripSnapshotModule> rightModules;
+	float rightWidth = 0.f;
+	std::vector<StripSnapshotModule> leftModules;
+	float leftWidth = 0.f;
+	std::vector<StripSnapshotCable> cables;
+
+	StripSnapshot() { }
+	StripSnapshot(const StripSnapshot&) = delete;
+	StripSnapshot& operator=(const StripSnapshot&) = delete;
+
+	~StripSnapshot() {
+		for (StripSnapshotModule& sm : rightModules) {
+			if (sm.dataJ) json_decref(sm.dataJ);
+		}
+		for (StripSnapshotModule& sm : leftModules) {
+			if (sm.dataJ) json_decref(sm.dataJ);
+		}
+	}
+
+	static json_t* moduleToJson(StripSnapshotModule& sm) {
+		json_t* moduleJ = json_object();
+		json_object_set_new(moduleJ, "plugin", json_string(sm.pluginSlug.c_str()));
+		json_object_set_new(moduleJ, "version", json_string(sm.version.c_str()));
+		json_object_set_new(moduleJ, "model", json_string(sm.modelSlug.c_str()));
+		json_object_set_new(moduleJ, "id", json_integer(sm.id));
+		json_t* paramsJ = json_array();
+		for (size_t i = 0; i < sm.paramIds.size(); i++) {
+			json_t* paramJ = json_object();
+			json_object_set_new(paramJ, "id", json_integer(sm.paramIds[i]));
+			json_object_set_new(paramJ, "value", json_real(sm.paramValues[i]));
+			json_array_append_new(paramsJ, paramJ);
+		}
+		json_object_set_new(moduleJ, "params", paramsJ);
+		if (sm.bypass) json_object_set_new(moduleJ, "bypass", json_boolean(sm.bypass));
+		if (sm.dataJ) json_object_set(moduleJ, "data", sm.dataJ);
+		return moduleJ;
+	}
+
+	static void moduleFromJson(StripSnapshotModule& sm, json_t* moduleJ) {
+		json_t* pluginSlugJ = json_object_get(moduleJ, "plugin");
+		if (pluginSlugJ) sm.pluginSlug = json_string_value(pluginSlugJ);
+		json_t* modelSlugJ = json_object_get(moduleJ, "model");
+		if (modelSlugJ) sm.modelSlug = json_string_value(modelSlugJ);
+		json_t* versionJ = json_object_get(moduleJ, "version");
+		if (versionJ) sm.version = json_string_value(versionJ);
+		json_t* idJ = json_object_get(moduleJ, "id");
+		sm.id = idJ ? json_integer_value(idJ) : -1;
+		sm.bypass = json_boolean_value(json_object_get(moduleJ, "bypass"));
+
+		json_t* paramsJ = json_object_get(moduleJ, "params");
+		json_t* paramJ;
+		size_t paramIndex;
+		json_array_foreach(paramsJ, paramIndex, paramJ) {
+			json_t* valueJ = json_object_get(paramJ, "value");
+			if (!valueJ) continue;
+			json_t* paramIdJ = json_object_get(paramJ, "id");
+			sm.paramIds.push_back(paramIdJ ? json_integer_value(paramIdJ) : paramIndex);
+			sm.paramValues.push_back(json_number_value(valueJ));
+		}
+
+		json_t* dataJ = json_object_get(moduleJ, "data");
+		if (dataJ) sm.dataJ = json_incref(dataJ);
+	}
+
+	void toJson(json_t* rootJ) {
+		json_t* rightModulesJ = json_array();
+		for (StripSnapshotModule& sm : rightModules) {
+			json_array_append_new(rightModulesJ, moduleToJson(sm));
+		}
+		json_t* leftModulesJ = json_array();
+		for (StripSnapshotModule& sm : leftModules) {
+			json_array_append_new(leftModulesJ, moduleToJson(sm));
+		}
+
+		json_t* cablesJ = json_array();
+		for (StripSnapshotCable& c : cables) {
+			json_t* cableJ = json_object();
+			json_object_set_new(cableJ, "outputModuleId", json_integer(c.outputModuleId));
+			json_object_set_new(cableJ, "outputId", json_integer(c.outputId));
+			json_object_set_new(cableJ, "inputModuleId", json_integer(c.inputModuleId));
+			json_object_set_new(cableJ, "inputId", json_integer(c.inputId));
+			json_object_set_new(cableJ, "color", json_string(c.color.c_str()));
+			json_array_append_new(cablesJ, cableJ);
+		}
+
+		json_object_set_new(rootJ, "stripVersion", json_integer(1));
+		json_object_set_new(rootJ, "rightModules", rightModulesJ);
+		json_object_set_new(rootJ, "rightWidth", json_real(rightWidth));
+		json_object_set_new(rootJ, "leftModules", leftModulesJ);
+		json_object_set_new(rootJ, "leftWidth", json_real(leftWidth));
+		json_object_set_new(rootJ, "cables", cablesJ);
+
+		json_t* versionJ = json_string(app::APP_VERSION.c_str());
+		json_object_set_new(rootJ, "version", versionJ);
+	}
+
+	void fromJson(json_t* rootJ) {
+		json_t* moduleJ;
+		size_t moduleIndex;
+		json_t* rightModulesJ = json_object_get(rootJ, "rightModules");
+		json_array_foreach(rightModulesJ, moduleIndex, moduleJ) {
+			rightModules.push_back(StripSnapshotModule());
+			moduleFromJson(rightModules.back(), moduleJ);
+		}
+		rightWidth = json_real_value(json_object_get(rootJ, "rightWidth"));
+		json_t* leftModulesJ = json_object_get(rootJ, "leftModules");
+		json_array_foreach(leftModulesJ, moduleIndex, moduleJ) {
+			leftModules.push_back(StripSnapshotModule());
+			moduleFromJson(leftModules.back(), moduleJ);
+		}
+		leftWidth = json_real_value(json_object_get(rootJ, "leftWidth"));
+
+		json_t* cablesJ = json_object_get(rootJ, "cables");
+		json_t* cableJ;
+		size_t cableIndex;
+		json_array_foreach(cablesJ, cableIndex, cableJ) {
+			StripSnapshotCable c;
+			c.outputModuleId = json_integer_value(json_object_get(cableJ, "outputModuleId"));
+			c.outputId = json_integer_value(json_object_get(cableJ, "outputId"));
+			c.inputModuleId = json_integer_value(json_object_get(cableJ, "inputModuleId"));
+			c.inputId = json_integer_value(json_object_get(cableJ, "inputId"));
+			const char* colorStr = json_string_value(json_object_get(cableJ, "color"));
+			if (colorStr) c.color = colorStr;
+			cables.push_back(c);
+		}
+	}
+}; // struct StripSnapshot
+
+/**
+ * The snapshot of the strip last put on the clipboard. It is shared between all instances of
+ * STRIP and outlives the patch, pasting the unchanged clipboard text reuses it without parsing.
+ */
+struct StripClipboard {
+	std::shared_ptr<StripSnapshot> snapshot;
+	size_t hash = 0;
+};
+
+inline StripClipboard& stripClipboard() {
+	static StripClipboard clipboard;
+	return clipboard;
+}
+
+
 template <class MODULE>
 struct StripWidgetBase : ThemedModuleWidget<MODULE> {
 	typedef ThemedModuleWidget<MODULE> BASE;
@@ -125,7 +297,7 @@ struct StripWidgetBase : ThemedModuleWidget<MODULE> {
 	/**
 	 *  Make enough space directly next to this instance of STRIP for the new modules.
 	 */
-	std::vector<history::Action*>* groupClearSpace(json_t* rootJ) {
+	std::vector<history::Action*>* groupClearSpace(StripSnapshot* snapshot) {
 		// To make sure there is enough space for the modules shove the existing modules to the 
 		// left and to the right. This is done by moving this instance of STRIP stepwise 1HP until enough
 		// space is cleared on both sides. Why this stupid and not just use setModulePosForce?
@@ -144,7 +316,7 @@ struct StripWidgetBase : ThemedModuleWidget<MODULE> {
 		}
 
 		if (module->mode == MODE::LEFTRIGHT || module->mode == MODE::RIGHT) {
-			float rightWidth = json_real_value(json_object_get(rootJ, "rightWidth"));
+			float rightWidth = snapshot->rightWidth;
 			if (rightWidth > 0.f) {
 				Vec pos = BASE::box.pos;
 				for (int i = 0; i < (rightWidth / RACK_GRID_WIDTH) + 4; i++) {
@@ -155,7 +327,7 @@ struct StripWidgetBase : ThemedModuleWidget<MODULE> {
 			}
 		}
 		if (module->mode == MODE::LEFTRIGHT || module->mode == MODE::LEFT) {
-			float leftWidth = json_real_value(json_object_get(rootJ, "leftWidth"));
+			float leftWidth = snapshot->leftWidth;
 				if (leftWidth > 0.f) {
 				Vec pos = BASE::box.pos;
 				for (int i = 0; i < (leftWidth / RACK_GRID_WIDTH) + 4; i++) {
@@ -304,26 +476,12 @@ struct StripWidgetBase : ThemedModuleWidget<MODULE> {
 	}
 
 	/**
-	 * Creates a module from json data, also returns the previous id of the module
-	 * @moduleJ
-	 * @oldId
+	 * Creates a module from a snapshot.
+	 * @sm
 	 */
-	ModuleWidget* moduleFromJson(json_t* moduleJ, int& oldId) {
-		// Get slugs
-		json_t* pluginSlugJ = json_object_get(moduleJ, "plugin");
-		if (!pluginSlugJ)
-			return NULL;
-		json_t* modelSlugJ = json_object_get(moduleJ, "model");
-		if (!modelSlugJ)
-			return NULL;
-		std::string pluginSlug = json_string_value(pluginSlugJ);
-		std::string modelSlug = json_string_value(modelSlugJ);
-
-		json_t* idJ = json_object_get(moduleJ, "id");
-		oldId = idJ ? json_integer_value(idJ) : -1;
-
+	ModuleWidget* moduleFromSnapshot(StripSnapshotModule& sm) {
 		// Get Model
-		plugin::Model* model = plugin::getModel(pluginSlug, modelSlug);
+		plugin::Model* model = plugin::getModel(sm.pluginSlug, sm.modelSlug);
 		if (!model)
 			return NULL;
 
@@ -334,14 +492,13 @@ struct StripWidgetBase : ThemedModuleWidget<MODULE> {
 	}
 
 	/**
-	 *  Adds a new module to the rack from a json-representation.
-	 * @moduleJ
+	 *  Adds a new module to the rack from a snapshot.
+	 * @sm
 	 * @left Should the module placed left or right of @box?
 	 * @box
-	 * @oldId
 	 */
-	ModuleWidget* moduleToRack(json_t* moduleJ, bool left, Rect& box, int& oldId) {
-		ModuleWidget* moduleWidget = moduleFromJson(moduleJ, oldId);
+	ModuleWidget* moduleToRack(StripSnapshotModule& sm, bool left, Rect& box) {
+		ModuleWidget* moduleWidget = moduleFromSnapshot(sm);
 		if (moduleWidget) {
 			moduleWidget->box.pos = left ? box.pos.minus(Vec(moduleWidget->box.size.x, 0)) : box.pos;
 			moduleWidget->module->id = -1;
@@ -352,70 +509,37 @@ struct StripWidgetBase : ThemedModuleWidget<MODULE> {
 			return moduleWidget;
 		}
 		else {
-			json_t* pluginSlugJ = json_object_get(moduleJ, "plugin");
-			std::string pluginSlug = json_string_value(pluginSlugJ);
-			json_t* modelSlugJ = json_object_get(moduleJ, "model");
-			std::string modelSlug = json_string_value(modelSlugJ);
-			warningLog += string::f("Could not find module \"%s\" of plugin \"%s\"\n", modelSlug.c_str(), pluginSlug.c_str());
+			warningLog += string::f("Could not find module \"%s\" of plugin \"%s\"\n", sm.modelSlug.c_str(), sm.pluginSlug.c_str());
 			box = Rect(box.pos, Vec(0, 0));
 			return NULL;
 		}
 	}
 
 	/**
-	 * Adds modules next to this module according to the supplied json-representation.
-	 * @rootJ json-representation of the STRIP-file
+	 * Adds modules next to this module according to the supplied snapshot.
+	 * @snapshot
 	 * @modules maps old module ids the new modules
+	 * @added the new modules in order of creation
 	 */
-	std::vector<history::Action*>* groupFromJson_modules(json_t* rootJ, std::map<int, ModuleWidget*>& modules) {
-		std::vector<history::Action*>* undoActions = new std::vector<history::Action*>;
-
+	void groupFromSnapshot_modules(StripSnapshot* snapshot, std::map<int, ModuleWidget*>& modules, std::vector<ModuleWidget*>& added) {
 		if (module->mode == MODE::LEFTRIGHT || module->mode == MODE::RIGHT) {
 			Rect box = this->box;
-			json_t* rightModulesJ = json_object_get(rootJ, "rightModules");
-			if (rightModulesJ) {
-				json_t* moduleJ;
-				size_t moduleIndex;
-				json_array_foreach(rightModulesJ, moduleIndex, moduleJ) {
-					int oldId;
-					box.pos = box.pos.plus(Vec(box.size.x, 0));
-					ModuleWidget* mw = moduleToRack(moduleJ, false, box, oldId);
-					// mw could be NULL, just move on
-					modules[oldId] = mw;
-
-					if (mw) {
-						// ModuleAdd history action
-						history::ModuleAdd* h = new history::ModuleAdd;
-						h->name = "create module";
-						h->setModule(mw);
-						undoActions->push_back(h);
-					}
-				}
+			for (StripSnapshotModule& sm : snapshot->rightModules) {
+				box.pos = box.pos.plus(Vec(box.size.x, 0));
+				ModuleWidget* mw = moduleToRack(sm, false, box);
+				// mw could be NULL, just move on
+				modules[sm.id] = mw;
+				if (mw) added.push_back(mw);
 			}
 		}
 		if (module->mode == MODE::LEFTRIGHT || module->mode == MODE::LEFT) {
 			Rect box = this->box;
-			json_t* leftModulesJ = json_object_get(rootJ, "leftModules");
-			if (leftModulesJ) {
-				json_t* moduleJ;
-				size_t moduleIndex;
-				json_array_foreach(leftModulesJ, moduleIndex, moduleJ) {
-					int oldId;
-					ModuleWidget* mw = moduleToRack(moduleJ, true, box, oldId);
-					modules[oldId] = mw;
-
-					if (mw) {
-						// ModuleAdd history action
-						history::ModuleAdd* h = new history::ModuleAdd;
-						h->name = "create module";
-						h->setModule(mw);
-						undoActions->push_back(h);
-					}
-				}
+			for (StripSnapshotModule& sm : snapshot->leftModules) {
+				ModuleWidget* mw = moduleToRack(sm, true, box);
+				modules[sm.id] = mw;
+				if (mw) added.push_back(mw);
 			}
 		}
-
-		return undoActions;
 	}
 
 	/**
@@ -423,18 +547,16 @@ struct StripWidgetBase : ThemedModuleWidget<MODULE> {
 	 * Rack v1 offers no API for reading the mapping module of a parameter. So this replaces the
 	 * module id in the preset JSON with the new module id to preserve correct mapping.
 	 * This means every module using mapping must be handled explicitly.
-	 * @moduleJ json-representation of the module
+	 * Returns a new reference of the module's data, the snapshot itself is left untouched.
+	 * @sm snapshot of the module
 	 * @modules maps old module ids the new modules
 	 */
-	void groupFromJson_presets_fixMapping(json_t* moduleJ, std::map<int, ModuleWidget*>& modules) {
-		std::string pluginSlug = json_string_value(json_object_get(moduleJ, "plugin"));
-		std::string modelSlug = json_string_value(json_object_get(moduleJ, "model"));
-
+	json_t* groupFromSnapshot_presets_fixMapping(StripSnapshotModule& sm, std::map<int, ModuleWidget*>& modules) {
 		// Only handle some specific modules known to use mapping of parameters
-		if (!(pluginSlug == "Core" && modelSlug == "MIDI-Map"))
-			return;
+		if (!(sm.pluginSlug == "Core" && sm.modelSlug == "MIDI-Map"))
+			return json_incref(sm.dataJ);
 
-		json_t* dataJ = json_object_get(moduleJ, "data");
+		json_t* dataJ = json_deep_copy(sm.dataJ);
 		json_t* mapsJ = json_object_get(dataJ, "maps");
 		if (mapsJ) {
 			json_t* mapJ;
@@ -454,169 +576,166 @@ struct StripWidgetBase : ThemedModuleWidget<MODULE> {
 				}
 			}
 		}
+		return dataJ;
+	}
+
+	/**
+	 * Loads a module's preset from its snapshot: parameters are set from the flat array,
+	 * only the module's data is passed as json.
+	 */
+	void groupFromSnapshot_presets_module(StripSnapshotModule& sm, std::map<int, ModuleWidget*>& modules) {
+		ModuleWidget* mw = modules[sm.id];
+		if (mw == NULL) return;
+		Module* m = mw->module;
+
+		for (size_t i = 0; i < sm.paramIds.size(); i++) {
+			int paramId = sm.paramIds[i];
+			if (paramId < 0 || paramId >= (int)m->params.size()) continue;
+			m->params[paramId].setValue(sm.paramValues[i]);
+		}
+		m->bypass = sm.bypass;
+
+		if (sm.dataJ) {
+			json_t* dataJ = groupFromSnapshot_presets_fixMapping(sm, modules);
+			StripIdFixModule* ifm = dynamic_cast<StripIdFixModule*>(m);
+			if (ifm) ifm->idFixDataFromJson(modules);
+			m->dataFromJson(dataJ);
+			json_decref(dataJ);
+		}
 	}
 
 	/**
-	 * Loads all the presets from a json-representation generated by STRIP. Assumes the modules are there.
+	 * Loads all the presets from a snapshot. Assumes the modules are there.
 	 * Presets of non-existing modules will be skipped.
-	 * @json json-representation of the STRIP-file
+	 * @snapshot
 	 * @modules maps old module ids the new modules
 	 */
-	std::vector<history::Action*>* groupFromJson_presets(json_t* rootJ, std::map<int, ModuleWidget*>& modules) {
-		std::vector<history::Action*>* undoActions = new std::vector<history::Action*>;
-
-		json_t* rightModulesJ = json_object_get(rootJ, "rightModules");
-		if (rightModulesJ) {
-			json_t* moduleJ;
-			size_t moduleIndex;
-			json_array_foreach(rightModulesJ, moduleIndex, moduleJ) {
-				if (module->mode == MODE::LEFTRIGHT || module->mode == MODE::RIGHT) {
-					groupFromJson_presets_fixMapping(moduleJ, modules);
-					int oldId = json_integer_value(json_object_get(moduleJ, "id"));
-					ModuleWidget* mw = modules[oldId];
-					if (mw != NULL) {
-						// history::ModuleChange
-						history::ModuleChange* h = new history::ModuleChange;
-						h->name = "load module preset";
-						h->moduleId = mw->module->id;
-						h->oldModuleJ = mw->toJson();
-
-						StripIdFixModule* m = dynamic_cast<StripIdFixModule*>(mw->module);
-						if (m) m->idFixDataFromJson(modules);
-
-						mw->fromJson(moduleJ);
-
-						h->newModuleJ = mw->toJson();
-						undoActions->push_back(h);
-					}
-				}
+	void groupFromSnapshot_presets(StripSnapshot* snapshot, std::map<int, ModuleWidget*>& modules) {
+		if (module->mode == MODE::LEFTRIGHT || module->mode == MODE::RIGHT) {
+			for (StripSnapshotModule& sm : snapshot->rightModules) {
+				groupFromSnapshot_presets_module(sm, modules);
 			}
 		}
-		json_t* leftModulesJ = json_object_get(rootJ, "leftModules");
-		if (leftModulesJ) {
-			json_t* moduleJ;
-			size_t moduleIndex;
-			json_array_foreach(leftModulesJ, moduleIndex, moduleJ) {
-				if (module->mode == MODE::LEFTRIGHT || module->mode == MODE::LEFT) {
-					groupFromJson_presets_fixMapping(moduleJ, modules);
-					int oldId = json_integer_value(json_object_get(moduleJ, "id"));
-					ModuleWidget* mw = modules[oldId];
-					if (mw != NULL) {
-						// history::ModuleChange
-						history::ModuleChange* h = new history::ModuleChange;
-						h->name = "load module preset";
-						h->moduleId = mw->module->id;
-						h->oldModuleJ = mw->toJson();
-
-						StripIdFixModule* m = dynamic_cast<StripIdFixModule*>(mw->module);
-						if (m) m->idFixDataFromJson(modules);
-
-						mw->fromJson(moduleJ);
-
-						h->newModuleJ = mw->toJson();
-						undoActions->push_back(h);
-					}
-				}
+		if (module->mode == MODE::LEFTRIGHT || module->mode == MODE::LEFT) {
+			for (StripSnapshotModule& sm : snapshot->leftModules) {
+				groupFromSnapshot_presets_module(sm, modules);
 			}
 		}
+	}
 
+	/**
+	 * Creates the undo actions for the added modules. This is done after the presets
+	 * have been loaded so no separate module changes need to be recorded.
+	 * @added the new modules in order of creation
+	 */
+	std::vector<history::Action*>* groupFromSnapshot_history(std::vector<ModuleWidget*>& added) {
+		std::vector<history::Action*>* undoActions = new std::vector<history::Action*>;
+		for (ModuleWidget* mw : added) {
+			// ModuleAdd history action
+			history::ModuleAdd* h = new history::ModuleAdd;
+			h->name = "create module";
+			h->setModule(mw);
+			undoActions->push_back(h);
+		}
 		return undoActions;
 	}
 
 	/**
-	 * Adds cables loaded from a json-representation generated by STRIP.
+	 * Adds cables from a snapshot.
 	 * If a module is missing the cable will be obviously skipped.
-	 * @rootJ json-representation of the STRIP-file
+	 * @snapshot
 	 * @modules maps old module ids the new modules
 	 */
-	std::vector<history::Action*>* groupFromJson_cables(json_t* rootJ, std::map<int, ModuleWidget*>& modules) {
+	std::vector<history::Action*>* groupFromSnapshot_cables(StripSnapshot* snapshot, std::map<int, ModuleWidget*>& modules) {
 		std::vector<history::Action*>* undoActions = new std::vector<history::Action*>;
 
-		json_t* cablesJ = json_object_get(rootJ, "cables");
-		if (cablesJ) {
-			json_t* cableJ;
-			size_t cableIndex;
-			json_array_foreach(cablesJ, cableIndex, cableJ) {
-				int outputModuleId = json_integer_value(json_object_get(cableJ, "outputModuleId"));
-				int outputId = json_integer_value(json_object_get(cableJ, "outputId"));
-				int inputModuleId = json_integer_value(json_object_get(cableJ, "inputModuleId"));
-				int inputId = json_integer_value(json_object_get(cableJ, "inputId"));
-				const char* colorStr = json_string_value(json_object_get(cableJ, "color"));
-
-				ModuleWidget* outputModule = modules[outputModuleId];
-				ModuleWidget* inputModule = modules[inputModuleId];
-				// In case one of the modules could not be loaded
-				if (!outputModule || !inputModule) continue;
-
-				CableWidget* cw = new CableWidget;
-				if (colorStr) {
-					cw->color = color::fromHexString(colorStr);
-				}
-				for (PortWidget* port : outputModule->outputs) {
-					if (port->portId == outputId) {
-						cw->setOutput(port);
-						break;
-					}
+		for (StripSnapshotCable& c : snapshot->cables) {
+			ModuleWidget* outputModule = modules[c.outputModuleId];
+			ModuleWidget* inputModule = modules[c.inputModuleId];
+			// In case one of the modules could not be loaded
+			if (!outputModule || !inputModule) continue;
+
+			CableWidget* cw = new CableWidget;
+			if (!c.color.empty()) {
+				cw->color = color::fromHexString(c.color);
+			}
+			for (PortWidget* port : outputModule->outputs) {
+				if (port->portId == c.outputId) {
+					cw->setOutput(port);
+					break;
 				}
-				for (PortWidget* port : inputModule->inputs) {
-					if (port->portId == inputId) {
-						cw->setInput(port);
-						break;
-					}
+			}
+			for (PortWidget* port : inputModule->inputs) {
+				if (port->portId == c.inputId) {
+					cw->setInput(port);
+					break;
 				}
-				if (cw->isComplete()) {
-					APP->scene->rack->addCable(cw);
+			}
+			if (cw->isComplete()) {
+				APP->scene->rack->addCable(cw);
 
-					// history::CableAdd
-					history::CableAdd* h = new history::CableAdd;
-					h->setCable(cw);
-					undoActions->push_back(h);
-				}
+				// history::CableAdd
+				history::CableAdd* h = new history::CableAdd;
+				h->setCable(cw);
+				undoActions->push_back(h);
+			}
+			else {
+				delete cw;
 			}
 		}
 
 		return undoActions;
 	}
 
+	StripSnapshotModule moduleToSnapshot(ModuleWidget* mw) {
+		Module* m = mw->module;
+		StripSnapshotModule sm;
+		sm.pluginSlug = mw->model->plugin->slug;
+		sm.modelSlug = mw->model->slug;
+		sm.version = mw->model->plugin->version;
+		sm.id = m->id;
+		sm.bypass = m->bypass;
+		sm.paramIds.reserve(m->params.size());
+		sm.paramValues.reserve(m->params.size());
+		for (size_t i = 0; i < m->params.size(); i++) {
+			// Don't store unbounded parameters, same as Module::toJson
+			if (m->paramQuantities[i] && !m->paramQuantities[i]->isBounded()) continue;
+			sm.paramIds.push_back(i);
+			sm.paramValues.push_back(m->params[i].getValue());
+		}
+		sm.dataJ = m->dataToJson();
+		return sm;
+	}
 
-	void groupToJson(json_t* rootJ) {
-		// Add modules
+	std::shared_ptr<StripSnapshot> groupToSnapshot() {
+		std::shared_ptr<StripSnapshot> snapshot = std::make_shared<StripSnapshot>();
 		std::set<ModuleWidget*> modules;
-		
-		float rightWidth = 0.f;
-		json_t* rightModulesJ = json_array();
+
 		if (module->mode == MODE::LEFTRIGHT || module->mode == MODE::RIGHT) {
 			Module* m = module;
 			while (true) {
 				if (!m || m->rightExpander.moduleId < 0) break;
 				ModuleWidget* mw = APP->scene->rack->getModule(m->rightExpander.moduleId);
-				json_t* moduleJ = mw->toJson();
-				assert(moduleJ);
-				json_array_append_new(rightModulesJ, moduleJ);
+				snapshot->rightModules.push_back(moduleToSnapshot(mw));
 				modules.insert(mw);
-				rightWidth += mw->box.size.x;
+				snapshot->rightWidth += mw->box.size.x;
 				m = m->rightExpander.module;
 			}
 		}
 
-		float leftWidth = 0.f;
-		json_t* leftModulesJ = json_array();
 		if (module->mode == MODE::LEFTRIGHT || module->mode == MODE::LEFT) {
 			Module* m = module;
 			while (true) {
 				if (!m || m->leftExpander.moduleId < 0) break;
 				ModuleWidget* mw = APP->scene->rack->getModule(m->leftExpander.moduleId);
-				json_t* moduleJ = mw->toJson();
-				assert(moduleJ);
-				json_array_append_new(leftModulesJ, moduleJ);
+				snapshot->leftModules.push_back(moduleToSnapshot(mw));
 				modules.insert(mw);
-				leftWidth += mw->box.size.x;
+				snapshot->leftWidth += mw->box.size.x;
 				m = m->leftExpander.module;
 			}
 		}
 
 		// Add cables
-		json_t* cablesJ = json_array();
 		for (auto i = modules.begin(); i != modules.end(); ++i) {
 			ModuleWidget* outputModule = *i;
 			// It is enough to check the outputs, as inputs don't matter when the other end is outside of the group
@@ -630,33 +749,28 @@ struct StripWidgetBase : ThemedModuleWidget<MODULE> {
 					if (modules.find(inputModule) == modules.end())
 						continue;
 
-					std::string colorStr = color::toHexString(cw->color);
-
-					json_t* cableJ = json_object();
-					json_object_set_new(cableJ, "outputModuleId", json_integer(output->module->id));
-					json_object_set_new(cableJ, "outputId", json_integer(output->portId));
-					json_object_set_new(cableJ, "inputModuleId", json_integer(input->module->id));
-					json_object_set_new(cableJ, "inputId", json_integer(input->portId));
-					json_object_set_new(cableJ, "color", json_string(colorStr.c_str()));
-					json_array_append_new(cablesJ, cableJ);
+					StripSnapshotCable c;
+					c.outputModuleId = output->module->id;
+					c.outputId = output->portId;
+					c.inputModuleId = input->module->id;
+					c.inputId = input->portId;
+					c.color = color::toHexString(cw->color);
+					snapshot->cables.push_back(c);
 				}
 			}
 		}
 
-		json_object_set_new(rootJ, "stripVersion", json_integer(1));
-		json_object_set_new(rootJ, "rightModules", rightModulesJ);
-		json_object_set_new(rootJ, "rightWidth", json_real(rightWidth));
-		json_object_set_new(rootJ, "leftModules", leftModulesJ);
-		json_object_set_new(rootJ, "leftWidth", json_real(leftWidth));
-		json_object_set_new(rootJ, "cables", cablesJ);
+		return snapshot;
+	}
 
-		json_t* versionJ = json_string(app::APP_VERSION.c_str());
-		json_object_set_new(rootJ, "version", versionJ);
+	void groupToJson(json_t* rootJ) {
+		groupToSnapshot()->toJson(rootJ);
 	}
 
 	void groupCopyClipboard() {
+		std::shared_ptr<StripSnapshot> snapshot = groupToSnapshot();
 		json_t* rootJ = json_object();
-		groupToJson(rootJ);
+		snapshot->toJson(rootJ);
 
 		DEFER({
 			json_decref(rootJ);
@@ -666,20 +780,15 @@ struct StripWidgetBase : ThemedModuleWidget<MODULE> {
 			free(moduleJson);
 		});
 		glfwSetClipboardString(APP->window->win, moduleJson);
+
+		// Keep the snapshot, a paste of the same text doesn't need to parse it again
+		StripClipboard& clipboard = stripClipboard();
+		clipboard.snapshot = snapshot;
+		clipboard.hash = std::hash<std::string>()(moduleJson);
 	}
 
 	void groupCutClipboard() {
-		json_t* rootJ = json_object();
-		groupToJson(rootJ);
-
-		DEFER({
-			json_decref(rootJ);
-		});
-		char* moduleJson = json_dumps(rootJ, JSON_INDENT(2) | JSON_REAL_PRECISION(9));
-		DEFER({
-			free(moduleJson);
-		});
-		glfwSetClipboardString(APP->window->win, moduleJson);
+		groupCopyClipboard();
 		groupRemove();
 	}
 
@@ -730,21 +839,23 @@ struct StripWidgetBase : ThemedModuleWidget<MODULE> {
 		groupSaveFile(pathStr);
 	}
 
-	void groupFromJson(json_t* rootJ) {
+	void groupFromSnapshot(StripSnapshot* snapshot) {
 		warningLog = "";
 
 		// Clear modules next to STRIP
-		std::vector<history::Action*>* h1 = groupClearSpace(rootJ);
+		std::vector<history::Action*>* h1 = groupClearSpace(snapshot);
 
 		// Maps old moduleId to the newly created module (with new id)
 		std::map<int, ModuleWidget*> modules;
+		std::vector<ModuleWidget*> added;
 		// Add modules
-		std::vector<history::Action*>* h2 = groupFromJson_modules(rootJ, modules);
+		groupFromSnapshot_modules(snapshot, modules, added);
 		// Load presets for modules, also fixes parameter mappings
-		std::vector<history::Action*>* h3 = groupFromJson_presets(rootJ, modules);
+		groupFromSnapshot_presets(snapshot, modules);
+		std::vector<history::Action*>* h2 = groupFromSnapshot_history(added);
 
 		// Add cables
-		std::vector<history::Action*>* h4 = groupFromJson_cables(rootJ, modules);
+		std::vector<history::Action*>* h3 = groupFromSnapshot_cables(snapshot, modules);
 
 		// Does nothing, but fixes https://github.com/VCVRack/Rack/issues/1444 for Rack <= 1.1.1
 		APP->scene->rack->requestModulePos(this, this->box.pos);
@@ -761,12 +872,10 @@ struct StripWidgetBase : ThemedModuleWidget<MODULE> {
 		delete h2;
 		for (history::Action* h : *h3) complexAction->push(h);
 		delete h3;
-		for (history::Action* h : *h4) complexAction->push(h);
-		delete h4;
 		APP->history->push(complexAction);
 	}
 
-	void groupReplaceFromJson(json_t* rootJ) {
+	void groupReplaceFromSnapshot(StripSnapshot* snapshot) {
 		warningLog = "";
 
 		std::list<std::tuple<std::string, int, PortWidget*, NVGcolor>> conn;
@@ -778,23 +887,25 @@ struct StripWidgetBase : ThemedModuleWidget<MODULE> {
 		groupRemove();
 
 		// Clear modules next to STRIP
-		std::vector<history::Action*>* h1 = groupClearSpace(rootJ);
+		std::vector<history::Action*>* h1 = groupClearSpace(snapshot);
 
 		// Maps old moduleId to the newly created module (with new id)
 		std::map<int, ModuleWidget*> modules;
+		std::vector<ModuleWidget*> added;
 		// Add modules
-		std::vector<history::Action*>* h2 = groupFromJson_modules(rootJ, modules);
+		groupFromSnapshot_modules(snapshot, modules, added);
 		// Load presets for modules, also fixes parameter mappings
-		std::vector<history::Action*>* h3 = groupFromJson_presets(rootJ, modules);
+		groupFromSnapshot_presets(snapshot, modules);
+		std::vector<history::Action*>* h2 = groupFromSnapshot_history(added);
 
 		// Add cables
-		std::vector<history::Action*>* h4 = groupFromJson_cables(rootJ, modules);
+		std::vector<history::Action*>* h3 = groupFromSnapshot_cables(snapshot, modules);
 
 		// Does nothing, but fixes https://github.com/VCVRack/Rack/issues/1444 for Rack <= 1.1.1
 		APP->scene->rack->requestModulePos(this, this->box.pos);
 
 		// Restore cables from StripCon-modules
-		std::vector<history::Action*>* h5 = groupConnectionsRestore(conn);
+		std::vector<history::Action*>* h4 = groupConnectionsRestore(conn);
 
 		if (!warningLog.empty()) {
 			osdialog_message(OSDIALOG_WARNING, OSDIALOG_OK, warningLog.c_str());
@@ -810,11 +921,21 @@ struct StripWidgetBase : ThemedModuleWidget<MODULE> {
 		delete h3;
 		for (history::Action* h : *h4) complexAction->push(h);
 		delete h4;
-		for (history::Action* h : *h5) complexAction->push(h);
-		delete h5;
 		APP->history->push(complexAction);
 	}
 
+	void groupFromJson(json_t* rootJ) {
+		StripSnapshot snapshot;
+		snapshot.fromJson(rootJ);
+		groupFromSnapshot(&snapshot);
+	}
+
+	void groupReplaceFromJson(json_t* rootJ) {
+		StripSnapshot snapshot;
+		snapshot.fromJson(rootJ);
+		groupReplaceFromSnapshot(&snapshot);
+	}
+
 	void groupPasteClipboard() {
 		const char* moduleJson = glfwGetClipboardString(APP->window->win);
 		if (!moduleJson) {
@@ -822,6 +943,14 @@ struct StripWidgetBase : ThemedModuleWidget<MODULE> {
 			return;
 		}
 
+		// The clipboard still holds the strip copied last, use its snapshot
+		StripClipboard& clipboard = stripClipboard();
+		if (clipboard.snapshot && clipboard.hash == std::hash<std::string>()(moduleJson)) {
+			std::shared_ptr<StripSnapshot> snapshot = clipboard.snapshot;
+			groupFromSnapshot(snapshot.get());
+			return;
+		}
+
 		json_error_t error;
 		json_t* rootJ = json_loads(moduleJson, 0, &error);
 		if (!rootJ) {
@@ -23,7 +23,8 @@ enum class SLOTCVMODE {
 	VOLT = 0,
 	C4 = 1,
 	ARM = 3,
-	PHASE = 11
+	PHASE = 11,
+	VECTOR = 12
 };
 
 enum class OUTMODE {
@@ -36,6 +37,129 @@ enum class OUTMODE {
 	PHASE = 5
 };
 
+/** Parameters of a running transition, resolved once when the transition starts */
+struct MorphTable {
+	std::vector<ParamHandle*> handles;
+	/** Module of each handle at the time of resolving, used for detecting removed modules */
+	std::vector<Module*> modules;
+	std::vector<ParamQuantity*> paramQuantities;
+	/** Value arrays, padded to a multiple of 4 */
+	std::vector<float> oldValues;
+	std::vector<float> newValues;
+	/** Non-zero for parameters whose target value is an integer */
+	std::vector<float> snapMask;
+	std::vector<float> values;
+	size_t count = 0;
+
+	void clear() {
+		handles.clear();
+		modules.clear();
+		paramQuantities.clear();
+		oldValues.clear();
+		newValues.clear();
+		snapMask.clear();
+		count = 0;
+	}
+
+	void push(ParamHandle* handle, ParamQuantity* paramQuantity, float oldValue, float newValue) {
+		handles.push_back(handle);
+		modules.push_back(handle->module);
+		paramQuantities.push_back(paramQuantity);
+		oldValues.push_back(oldValue);
+		newValues.push_back(newValue);
+		snapMask.push_back(std::abs(std::round(newValue) - newValue) < 5e-3f ? 1.f : 0.f);
+		count++;
+	}
+
+	void pad() {
+		size_t size = (count + 3) / 4 * 4;
+		oldValues.resize(size, 0.f);
+		newValues.resize(size, 0.f);
+		snapMask.resize(size, 0.f);
+		values.resize(size, 0.f);
+	}
+
+	/** Crossfades all parameters to position s in [0, 1] and writes the results */
+	void process(float s) {
+		bool snap = s > (1.f - 5e-3f);
+		for (size_t i = 0; i < count; i += 4) {
+			simd::float_4 a = simd::float_4::load(&oldValues[i]);
+			simd::float_4 b = simd::float_4::load(&newValues[i]);
+			simd::float_4 v = a + (b - a) * s;
+			if (snap) {
+				simd::float_4 r = simd::round(v);
+				simd::float_4 m = (simd::float_4::load(&snapMask[i]) != 0.f) & (simd::fabs(r - v) < 5e-3f);
+				v = simd::ifelse(m, r, v);
+			}
+			v.store(&values[i]);
+		}
+		for (size_t i = 0; i < count; i++) {
+			if (handles[i]->module != modules[i]) continue;
+			paramQuantities[i]->setValue(values[i]);
+		}
+	}
+}; // struct MorphTable
+
+/** Parameters and corner snapshots used by the vector-morph mode */
+struct VectorTable {
+	static const int CORNERS = 4;
+
+	std::vector<ParamHandle*> handles;
+	std::vector<Module*> modules;
+	std::vector<ParamQuantity*> paramQuantities;
+	/** Value arrays of the corner snapshots, padded to a multiple of 4 */
+	std::vector<float> cornerValues[CORNERS];
+	std::vector<float> values;
+	size_t count = 0;
+
+	void clear() {
+		handles.clear();
+		modules.clear();
+		paramQuantities.clear();
+		for (int k = 0; k < CORNERS; k++) {
+			cornerValues[k].clear();
+		}
+		count = 0;
+	}
+
+	void push(ParamHandle* handle, ParamQuantity* paramQuantity, const float* corners) {
+		handles.push_back(handle);
+		modules.push_back(handle->module);
+		paramQuantities.push_back(paramQuantity);
+		for (int k = 0; k < CORNERS; k++) {
+			cornerValues[k].push_back(corners[k]);
+		}
+		count++;
+	}
+
+	void pad() {
+		size_t size = (count + 3) / 4 * 4;
+		for (int k = 0; k < CORNERS; k++) {
+			cornerValues[k].resize(size, 0.f);
+		}
+		values.resize(size, 0.f);
+	}
+
+	/** Blends the corner snapshots using the given weights and writes the results */
+	void process(const float* weights) {
+		simd::float_4 w0 = weights[0];
+		simd::float_4 w1 = weights[1];
+		simd::float_4 w2 = weights[2];
+		simd::float_4 w3 = weights[3];
+		for (size_t i = 0; i < count; i += 4) {
+			simd::float_4 v = simd::float_4::load(&cornerValues[0][i]) * w0;
+			v += simd::float_4::load(&cornerValues[1][i]) * w1;
+			v += simd::float_4::load(&cornerValues[2][i]) * w2;
+			v += simd::float_4::load(&cornerValues[3][i]) * w3;
+			v.store(&values[i]);
+		}
+		for (size_t i = 0; i < count; i++) {
+			if (handles[i]->module != modules[i]) continue;
+			paramQuantities[i]->setValue(values[i]);
+		}
+	}
+}; // struct VectorTable
+
 template <int NUM_PRESETS>
 struct TransitModule : TransitBase<NUM_PRESETS> {
 	typedef TransitBase<NUM_PRESETS> BASE;
@@ -70,14 +194,24 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 	int presetCount;
 
 	/** Total number of snapshots including expanders */
-	int presetTotal;
+	int presetTotal = NUM_PRESETS;
 	int presetNext;
 	int presetCopy = -1;
 	float presetPhaseLast = -1.f;
 
-	/** Holds the last values on transitions */
-	std::vector<float> presetOld;
-	std::vector<float> presetNew;
+	/** Holds the old and new values of the current transition */
+	MorphTable morph;
+
+	VectorTable vectorTable;
+	/** Set when the snapshots or bindings have changed and the vector table must be rebuilt */
+	bool vectorDirty = true;
+	/** [Stored to JSON] slot placed on each corner in vector-mode, -1 if the corner is unused */
+	int vectorSlot[VectorTable::CORNERS] = {0, 1, 2, 3};
+	/** Slots of the active corners, unused corners skipped */
+	int vectorCornerSlot[VectorTable::CORNERS] = {};
+	int vectorCorners = 0;
+	float vectorWeight[VectorTable::CORNERS] = {};
+	float vectorLast[2] = {-1.f, -1.f};
 
 	/** [Stored to JSON] mode for SEQ CV input */
 	SLOTCVMODE slotCvMode = SLOTCVMODE::TRIG_FWD;
@@ -111,6 +245,7 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 	dsp::Timer resetTimer;
 
 	StoermelderShapedSlewLimiter slewLimiter;
+	StoermelderShapedSlewLimiter slewLimiterY;
 	dsp::ClockDivider handleDivider;
 	dsp::ClockDivider buttonDivider;
 
@@ -121,8 +256,11 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 
 	int sampleRate;
 
+	/** Cached chain of this module and its expanders */
 	TransitBase<NUM_PRESETS>* N[MAX_EXPANDERS + 1];
-	
+	int expanderCount = 0;
+	int expanderPanelTheme = -1;
+	CTRLMODE expanderCtrlMode = CTRLMODE::READ;
 
 	TransitModule() {
 		BASE::panelTheme = pluginSettings.panelThemeDefault;
@@ -164,6 +302,9 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 			delete sourceHandle;
 		}
 		sourceHandles.clear();
+		morph.clear();
+		vectorTable.clear();
+		vectorDirty = true;
 		inChange = false;
 
 		for (int i = 0; i < NUM_PRESETS; i++) {
@@ -178,6 +319,9 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 		slewLimiter.reset(10.f);
 
 		outMode = OUTMODE::ENV;
+		for (int k = 0; k < VectorTable::CORNERS; k++) {
+			vectorSlot[k] = k;
+		}
 		outSlotPulseGenerator.reset();
 		outSocPulseGenerator.reset();
 		outEocPulseGenerator.reset();
@@ -221,27 +365,12 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 		if (inChange) return;
 		sampleRate = args.sampleRate;
 
-		presetTotal = NUM_PRESETS;
-		Module* m = this;
-		TransitBase<NUM_PRESETS>* t = this;
-		t->ctrlMode = (CTRLMODE)Module::params[PARAM_CTRLMODE].getValue();
-		int c = 0;
-		while (true) {
-			N[c] = t;
-			c++;
-			if (c == MAX_EXPANDERS + 1) break;
-
-			Module* exp = m->rightExpander.module;
-			if (!exp) break;
-			if (exp->model != modelTransitEx) break;
-			m = exp;
-			t = reinterpret_cast<TransitBase<NUM_PRESETS>*>(exp);
-			if (t->ctrlModuleId >= 0 && t->ctrlModuleId != Module::id) t->onReset();
-			t->panelTheme = BASE::panelTheme;
-			t->ctrlModuleId = Module::id;
-			t->ctrlOffset = c;
-			t->ctrlMode = BASE::ctrlMode;
-			presetTotal += NUM_PRESETS;
+		BASE::ctrlMode = (CTRLMODE)Module::params[PARAM_CTRLMODE].getValue();
+		if (expanderChanged()) {
+			expanderUpdate();
+		}
+		else if (expanderCtrlMode != BASE::ctrlMode || expanderPanelTheme != BASE::panelTheme) {
+			expanderSync();
 		}
 		int presetCount = std::min(this->presetCount, presetTotal);
 
@@ -392,7 +521,12 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 			if (BASE::ctrlMode == CTRLMODE::READ) {
 				presetProcessPhase(args.sampleTime);
 			}
-		} 
+		}
+		else if (isVectorCvActive()) {
+			if (BASE::ctrlMode == CTRLMODE::READ) {
+				presetProcessVector(args.sampleTime);
+			}
+		}
 		else {
 			presetProcess(args.sampleTime);
 		}
@@ -410,13 +544,17 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 				TransitSlot* slot = expSlot(i);
 				bool u = *(slot->presetSlotUsed);
 				if (BASE::ctrlMode == CTRLMODE::READ || BASE::ctrlMode == CTRLMODE::AUTO) {
-					if (!isPhaseCvActive()) {
+					if (!isPhaseCvActive() && !isVectorCvActive()) {
 						slot->lights[0].setBrightness(preset == i ? 1.f : (presetNext == i ? 1.f : 0.f));
 						slot->lights[1].setBrightness(preset == i ? 1.f : (presetCount > i ? (u ? 1.f : 0.25f) : 0.f));
 						slot->lights[2].setBrightness(preset == i ? 1.f : 0.f);
 					}
 					else {
-						float f = (intpart == i) ? (1.f - frac) : (intpart + 1 == i) ? (frac) : 0.f;
+						float f;
+						if (isVectorCvActive())
+							f = vectorSlotWeight(i);
+						else
+							f = (intpart == i) ? (1.f - frac) : (intpart + 1 == i) ? (frac) : 0.f;
 						slot->lights[0].setBrightness(f);
 						slot->lights[1].setBrightness(std::max(f, presetCount > i ? (u ? 1.f : 0.25f) : 0.f));
 						slot->lights[2].setBrightness(f);
@@ -430,14 +568,69 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 				}
 			}
 
-			BASE::lights[LIGHT_CV].setBrightness((slotCvMode == SLOTCVMODE::OFF || (slotCvMode == SLOTCVMODE::PHASE && BASE::ctrlMode == CTRLMODE::WRITE)) && lightBlink);
+			BASE::lights[LIGHT_CV].setBrightness((slotCvMode == SLOTCVMODE::OFF || ((slotCvMode == SLOTCVMODE::PHASE || slotCvMode == SLOTCVMODE::VECTOR) && BASE::ctrlMode == CTRLMODE::WRITE)) && lightBlink);
+		}
+	}
+
+	/** Checks the chain of expanders against the cached chain without writing into any module */
+	bool expanderChanged() {
+		Module* m = this;
+		int c = 1;
+		while (c < MAX_EXPANDERS + 1) {
+			Module* exp = m->rightExpander.module;
+			if (!exp) break;
+			if (exp->model != modelTransitEx) break;
+			if (c >= expanderCount || N[c] != exp || N[c]->ctrlModuleId != Module::id) return true;
+			m = exp;
+			c++;
+		}
+		return c != expanderCount;
+	}
+
+	/** Rebuilds the cached chain and takes control of all attached expanders */
+	void expanderUpdate() {
+		presetTotal = NUM_PRESETS;
+		Module* m = this;
+		TransitBase<NUM_PRESETS>* t = this;
+		int c = 0;
+		while (true) {
+			N[c] = t;
+			c++;
+			if (c == MAX_EXPANDERS + 1) break;
+
+			Module* exp = m->rightExpander.module;
+			if (!exp) break;
+			if (exp->model != modelTransitEx) break;
+			m = exp;
+			t = reinterpret_cast<TransitBase<NUM_PRESETS>*>(exp);
+			if (t->ctrlModuleId >= 0 && t->ctrlModuleId != Module::id) t->onReset();
+			t->ctrlModuleId = Module::id;
+			t->ctrlOffset = c;
+			presetTotal += NUM_PRESETS;
 		}
+		expanderCount = c;
+		expanderSync();
+		vectorDirty = true;
+	}
+
+	/** Passes panel theme and mode to the expanders, only needed when one of them changes */
+	void expanderSync() {
+		for (int c = 1; c < expanderCount; c++) {
+			N[c]->panelTheme = BASE::panelTheme;
+			N[c]->ctrlMode = BASE::ctrlMode;
+		}
+		expanderPanelTheme = BASE::panelTheme;
+		expanderCtrlMode = BASE::ctrlMode;
 	}
 
 	inline bool isPhaseCvActive() {
 		return slotCvMode == SLOTCVMODE::PHASE && BASE::inputs[INPUT_CV].isConnected();
 	}
 
+	inline bool isVectorCvActive() {
+		return slotCvMode == SLOTCVMODE::VECTOR && BASE::inputs[INPUT_CV].isConnected();
+	}
+
 	ParamQuantity* getParamQuantity(ParamHandle* handle) {
 		if (handle->moduleId < 0)
 			return NULL;
@@ -482,6 +675,7 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 		APP->engine->updateParamHandle(sourceHandle, moduleId, paramId, true);
 		inChange = true;
 		sourceHandles.push_back(sourceHandle);
+		vectorDirty = true;
 		inChange = false;
 
 		ParamQuantity* pq = getParamQuantity(sourceHandle);
@@ -521,15 +715,18 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 				slewLimiter.reset();
 				outSocPulseGenerator.trigger();
 				outEocArm = true;
-				presetOld.clear();
-				presetNew.clear();
+				morph.clear();
 				for (size_t i = 0; i < sourceHandles.size(); i++) {
+					if (slot->preset->size() <= i) break;
 					ParamQuantity* pq = getParamQuantity(sourceHandles[i]);
-					presetOld.push_back(pq ? pq->getValue() : 0.f);
-					if (slot->preset->size() > i) {
-						presetNew.push_back((*(slot->preset))[i]);
-					}
+					if (!pq) continue;
+					float oldValue = pq->getValue();
+					float newValue = (*(slot->preset))[i];
+					// Parameters already at their target value are left alone during the transition
+					if (oldValue == newValue) continue;
+					morph.push(sourceHandles[i], pq, oldValue, newValue);
 				}
+				morph.pad();
 			}
 		}
 		else {
@@ -589,18 +786,7 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 
 			if (s == 10.f) return;
 			s /= 10.f;
-
-			for (size_t i = 0; i < sourceHandles.size(); i++) {
-				ParamQuantity* pq = getParamQuantity(sourceHandles[i]);
-				if (!pq) continue;
-				if (presetOld.size() <= i) return;
-				float oldValue = presetOld[i];
-				if (presetNew.size() <= i) return;
-				float newValue = presetNew[i];
-				float v = crossfade(oldValue, newValue, s);
-				if (s > (1.f - 5e-3f) && std::abs(std::round(v) - v) < 5e-3f) v = std::round(v);
-				pq->setValue(v);
-			}
+			morph.process(s);
 		}
 	}
 
@@ -664,6 +850,125 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 		}
 	}
 
+	void presetProcessVector(float sampleTime) {
+		if (presetProcessDivider.process()) {
+			preset = -1;
+			float deltaTime = sampleTime * presetProcessDivision;
+
+			Input& input = BASE::inputs[INPUT_CV];
+			float x = clamp(input.getVoltage(0), 0.f, 10.f);
+			float y = input.getChannels() > 1 ? clamp(input.getVoltage(1), 0.f, 10.f) : 0.f;
+
+			float fade = BASE::inputs[INPUT_FADE].getVoltage() / 10.f + BASE::params[PARAM_FADE].getValue();
+			slewLimiter.setRiseFall(fade, fade);
+			slewLimiterY.setRiseFall(fade, fade);
+			float shape = BASE::params[PARAM_SHAPE].getValue();
+			slewLimiter.setShape(shape);
+			slewLimiterY.setShape(shape);
+			x = slewLimiter.process(x, deltaTime);
+			y = slewLimiterY.process(y, deltaTime);
+
+			BASE::outputs[OUTPUT].setVoltage(x, 0);
+			BASE::outputs[OUTPUT].setVoltage(y, 1);
+			BASE::outputs[OUTPUT].setChannels(2);
+
+			if (vectorDirty) {
+				vectorBuild();
+			}
+			else if (vectorLast[0] == x && vectorLast[1] == y) {
+				return;
+			}
+			vectorLast[0] = x;
+			vectorLast[1] = y;
+
+			if (!vectorWeights(x / 10.f, y / 10.f)) return;
+			vectorTable.process(vectorWeight);
+		}
+	}
+
+	/** Resolves the bound parameters and the values of the corner snapshots */
+	void vectorBuild() {
+		vectorDirty = false;
+		vectorTable.clear();
+		vectorCorners = 0;
+		int n = std::min(presetCount, presetTotal);
+		for (int k = 0; k < VectorTable::CORNERS; k++) {
+			if (vectorSlot[k] >= 0 && vectorSlot[k] < n) vectorCornerSlot[vectorCorners++] = vectorSlot[k];
+		}
+		for (size_t i = 0; i < sourceHandles.size(); i++) {
+			ParamQuantity* pq = getParamQuantity(sourceHandles[i]);
+			if (!pq) continue;
+			float v = pq->getValue();
+			float corners[VectorTable::CORNERS];
+			for (int k = 0; k < VectorTable::CORNERS; k++) {
+				TransitSlot* slot = k < vectorCorners ? expSlot(vectorCornerSlot[k]) : NULL;
+				bool u = slot && *(slot->presetSlotUsed) && slot->preset->size() > i;
+				corners[k] = u ? (*(slot->preset))[i] : v;
+			}
+			vectorTable.push(sourceHandles[i], pq, corners);
+		}
+		vectorTable.pad();
+	}
+
+	/**
+	 * Computes the weights of the corner snapshots for position (x, y) in [0, 1]:
+	 * barycentric on a triangle for three slots, bilinear on a square for four slots.
+	 * Returns false if none of the corner slots is used.
+	 */
+	bool vectorWeights(float x, float y) {
+		float* w = vectorWeight;
+		switch (vectorCorners) {
+			case 4:
+				w[0] = (1.f - x) * (1.f - y);
+				w[1] = x * (1.f - y);
+				w[2] = (1.f - x) * y;
+				w[3] = x * y;
+				break;
+			case 3:
+				if (x + y > 1.f) {
+					float s = x + y;
+					x /= s;
+					y /= s;
+				}
+				w[0] = 1.f - x - y;
+				w[1] = x;
+				w[2] = y;
+				w[3] = 0.f;
+				break;
+			case 2:
+				w[0] = 1.f - x;
+				w[1] = x;
+				w[2] = w[3] = 0.f;
+				break;
+			default:
+				w[0] = 1.f;
+				w[1] = w[2] = w[3] = 0.f;
+				break;
+		}
+
+		// Empty slots do not take part in the blend
+		float sum = 0.f;
+		for (int k = 0; k < VectorTable::CORNERS; k++) {
+			TransitSlot* slot = k < vectorCorners ? expSlot(vectorCornerSlot[k]) : NULL;
+			if (!slot || !*(slot->presetSlotUsed)) w[k] = 0.f;
+			sum += w[k];
+		}
+		if (sum == 0.f) return false;
+		for (int k = 0; k < VectorTable::CORNERS; k++) {
+			w[k] /= sum;
+		}
+		return true;
+	}
+
+	/** Returns the blend weight of slot p in vector-mode, summed if the slot is placed on several corners */
+	float vectorSlotWeight(int p) {
+		float f = 0.f;
+		for (int k = 0; k < vectorCorners; k++) {
+			if (vectorCornerSlot[k] == p) f += vectorWeight[k];
+		}
+		return f;
+	}
+
 	void presetSave(int p) {
 		TransitSlot* slot = expSlot(p);
 		*(slot->presetSlotUsed) = true;
@@ -675,6 +980,7 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 		}
 		assert(sourceHandles.size() == slot->preset->size());
 		preset = p;
+		vectorDirty = true;
 	}
 
 	void presetClear(int p) {
@@ -683,12 +989,14 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 		slot->preset->clear();
 		*expSlotLabel(p) = "";
 		if (preset == p) preset = -1;
+		vectorDirty = true;
 	}
 
 	void presetSetCount(int p) {
 		if (preset >= p) preset = 0;
 		presetCount = p;
 		presetNext = -1;
+		vectorDirty = true;
 	}
 
 	void presetRandomize(int p) {
@@ -712,6 +1020,7 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 		}
 		assert(sourceHandles.size() == slot->preset->size());
 		preset = p;
+		vectorDirty = true;
 	}
 
 	void presetCopyPaste(int source, int target) {
@@ -726,6 +1035,7 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 			targetPreset->push_back(v);
 		}
 		if (preset == target) preset = -1;
+		vectorDirty = true;
 	}
 
 	void presetShiftBack(int p) {
@@ -768,16 +1078,22 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 
 	void setCvMode(SLOTCVMODE mode) {
 		slotCvMode = slotCvModeBak = mode;
-		if (slotCvMode == SLOTCVMODE::PHASE) outMode = OUTMODE::PHASE;
+		if (slotCvMode == SLOTCVMODE::PHASE || slotCvMode == SLOTCVMODE::VECTOR) outMode = OUTMODE::PHASE;
 		else if (outMode == OUTMODE::PHASE) outMode = OUTMODE::ENV;
+		vectorDirty = true;
 	}
 
 	void setOutMode(OUTMODE mode) {
 		outMode = mode;
-		if (slotCvMode == SLOTCVMODE::PHASE) outMode = OUTMODE::PHASE;
+		if (slotCvMode == SLOTCVMODE::PHASE || slotCvMode == SLOTCVMODE::VECTOR) outMode = OUTMODE::PHASE;
 		else if (outMode == OUTMODE::PHASE) outMode = OUTMODE::ENV;
 	}
 
+	void setVectorSlot(int corner, int p) {
+		vectorSlot[corner] = p;
+		vectorDirty = true;
+	}
+
 	int transitSlotCmd(SLOT_CMD cmd, int i) override {
 		switch (cmd) {
 			case SLOT_CMD::LOAD:
@@ -821,6 +1137,12 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 		json_object_set_new(rootJ, "preset", json_integer(preset));
 		json_object_set_new(rootJ, "presetCount", json_integer(presetCount));
 
+		json_t* vectorSlotsJ = json_array();
+		for (int k = 0; k < VectorTable::CORNERS; k++) {
+			json_array_append_new(vectorSlotsJ, json_integer(vectorSlot[k]));
+		}
+		json_object_set_new(rootJ, "vectorSlots", vectorSlotsJ);
+
 		json_t* sourceMapsJ = json_array();
 		for (size_t i = 0; i < sourceHandles.size(); i++) {
 			json_t* sourceMapJ = json_object();
@@ -847,10 +1169,18 @@ struct TransitModule : TransitBase<NUM_PRESETS> {
 			preset = -1;
 		}
 
+		json_t* vectorSlotsJ = json_object_get(rootJ, "vectorSlots");
+		for (int k = 0; k < VectorTable::CORNERS; k++) {
+			json_t* vectorSlotJ = json_array_get(vectorSlotsJ, k);
+			vectorSlot[k] = vectorSlotJ ? json_integer_value(vectorSlotJ) : k;
+		}
+
 		// Hack for preventing duplicating this module
 		if (APP->engine->getModule(BASE::id) != NULL && !BASE::idFixHasMap()) return;
 
 		inChange = true;
+		morph.clear();
+		vectorDirty = true;
 		json_t* sourceMapsJ = json_object_get(rootJ, "sourceMaps");
 		if (sourceMapsJ) {
 			json_t* sourceMapJ;
@@ -1080,6 +1410,7 @@ struct TransitWidget : ThemedModuleWidget<TransitModule<NUM_PRESETS>> {
 				menu->addChild(construct<SlotCvModeItem>(&MenuItem::text, "Arm", &SlotCvModeItem::module, module, &SlotCvModeItem::slotCvMode, SLOTCVMODE::ARM));
 				menu->addChild(new MenuSeparator);
 				menu->addChild(construct<SlotCvModeItem>(&MenuItem::text, "Phase", &SlotCvModeItem::module, module, &SlotCvModeItem::slotCvMode, SLOTCVMODE::PHASE));
+				menu->addChild(construct<SlotCvModeItem>(&MenuItem::text, "Vector", &SlotCvModeItem::module, module, &SlotCvModeItem::slotCvMode, SLOTCVMODE::VECTOR));
 				menu->addChild(new MenuSeparator);
 				menu->addChild(construct<SlotCvModeItem>(&MenuItem::text, "Off", &SlotCvModeItem::rightTextEx, RACK_MOD_SHIFT_NAME "+Q", &SlotCvModeItem::module, module, &SlotCvModeItem::slotCvMode, SLOTCVMODE::OFF));
 				return menu;
@@ -1105,7 +1436,7 @@ struct TransitWidget : ThemedModuleWidget<TransitModule<NUM_PRESETS>> {
 			}
 
 			Menu* createChildMenu() override {
-				bool phaseMode = module->slotCvMode == SLOTCVMODE::PHASE;
+				bool phaseMode = module->slotCvMode == SLOTCVMODE::PHASE || module->slotCvMode == SLOTCVMODE::VECTOR;
 				Menu* menu = new Menu;
 				menu->addChild(construct<OutModeItem>(&MenuItem::text, "Envelope", &OutModeItem::module, module, &OutModeItem::outMode, OUTMODE::ENV, &OutModeItem::disabled, phaseMode));
 				menu->addChild(construct<OutModeItem>(&MenuItem::text, "Gate", &OutModeItem::module, module, &OutModeItem::outMode, OUTMODE::GATE, &OutModeItem::disabled, phaseMode));
@@ -1120,6 +1451,53 @@ struct TransitWidget : ThemedModuleWidget<TransitModule<NUM_PRESETS>> {
 			}
 		};
 
+		struct VectorCornerMenuItem : MenuItem {
+			struct VectorSlotItem : MenuItem {
+				MODULE* module;
+				int corner;
+				int slot;
+				void onAction(const event::Action& e) override {
+					module->setVectorSlot(corner, slot);
+				}
+				void step() override {
+					rightText = module->vectorSlot[corner] == slot ? "✔" : "";
+					MenuItem::step();
+				}
+			};
+
+			MODULE* module;
+			int corner;
+			VectorCornerMenuItem() {
+				rightText = RIGHT_ARROW;
+			}
+
+			Menu* createChildMenu() override {
+				Menu* menu = new Menu;
+				menu->addChild(construct<VectorSlotItem>(&MenuItem::text, "Off", &VectorSlotItem::module, module, &VectorSlotItem::corner, corner, &VectorSlotItem::slot, -1));
+				menu->addChild(new MenuSeparator);
+				for (int i = 0; i < module->presetTotal; i++) {
+					menu->addChild(construct<VectorSlotItem>(&MenuItem::text, string::f("Slot %d", i + 1), &VectorSlotItem::module, module, &VectorSlotItem::corner, corner, &VectorSlotItem::slot, i));
+				}
+				return menu;
+			}
+		};
+
+		struct VectorCornersMenuItem : MenuItem {
+			MODULE* module;
+			VectorCornersMenuItem() {
+				rightText = RIGHT_ARROW;
+			}
+
+			Menu* createChildMenu() override {
+				Menu* menu = new Menu;
+				menu->addChild(construct<VectorCornerMenuItem>(&MenuItem::text, "Bottom-left", &VectorCornerMenuItem::module, module, &VectorCornerMenuItem::corner, 0));
+				menu->addChild(construct<VectorCornerMenuItem>(&MenuItem::text, "Bottom-right", &VectorCornerMenuItem::module, module, &VectorCornerMenuItem::corner, 1));
+				menu->addChild(construct<VectorCornerMenuItem>(&MenuItem::text, "Top-left", &VectorCornerMenuItem::module, module, &VectorCornerMenuItem::corner, 2));
+				menu->addChild(construct<VectorCornerMenuItem>(&MenuItem::text, "Top-right", &VectorCornerMenuItem::module, module, &VectorCornerMenuItem::corner, 3));
+				return menu;
+			}
+		};
+
 		struct BindModuleItem : MenuItem {
 			MODULE* module;
 			WIDGET* widget;
@@ -1240,12 +1618,21 @@ struct TransitWidget : ThemedModuleWidget<TransitModule<NUM_PRESETS>> {
 			}
 		};
 
+		struct MorphedLabel : MenuLabel {
+			MODULE* module;
+			void step() override {
+				text = string::f("Morphed parameters: %i of %i", (int)module->morph.count, (int)module->sourceHandles.size());
+				MenuLabel::step();
+			}
+		};
+
 		menu->addChild(new MenuSeparator());
 		menu->addChild(construct<MappingIndicatorHiddenItem>(&MenuItem::text, "Hide mapping indicators", &MappingIndicatorHiddenItem::module, module));
 		menu->addChild(construct<PrecisionMenuItem>(&MenuItem::text, "Precision", &PrecisionMenuItem::module, module));
 		menu->addChild(new MenuSeparator());
 		menu->addChild(construct<SlotCvModeMenuItem>(&MenuItem::text, "Port CV mode", &SlotCvModeMenuItem::module, module));
 		menu->addChild(construct<OutModeMenuItem>(&MenuItem::text, "Port OUT mode", &OutModeMenuItem::module, module));
+		menu->addChild(construct<VectorCornersMenuItem>(&MenuItem::text, "Vector corners", &VectorCornersMenuItem::module, module));
 		menu->addChild(new MenuSeparator());
 		menu->addChild(construct<BindModuleItem>(&MenuItem::text, "Bind module (left)", &BindModuleItem::widget, this, &BindModuleItem::module, module));
 		menu->addChild(construct<BindModuleSelectItem>(&MenuItem::text, "Bind module (select)", &BindModuleSelectItem::widget, this));
@@ -1256,6 +1643,7 @@ struct TransitWidget : ThemedModuleWidget<TransitModule<NUM_PRESETS>> {
 			menu->addChild(new MenuSeparator());
 			menu->addChild(construct<ModuleMenuItem>(&MenuItem::text, "Bound modules", &ModuleMenuItem::module, module));
 			menu->addChild(construct<ParameterMenuItem>(&MenuItem::text, "Bound parameters", &ParameterMenuItem::module, module));
+			menu->addChild(construct<MorphedLabel>(&MorphedLabel::module, module));
 		}
 	}
 };
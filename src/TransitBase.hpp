@@ -66,12 +66,10 @@ struct TransitBase : Module, StripIdFixModule {
 			json_object_set_new(presetJ, "slotUsed", json_boolean(TransitBase<NUM_PRESETS>::presetSlotUsed[i]));
 			json_object_set_new(presetJ, "textLabel", json_string(TransitBase<NUM_PRESETS>::textLabel[i].c_str()));
 			if (TransitBase<NUM_PRESETS>::presetSlotUsed[i]) {
-				json_t* slotJ = json_array();
-				for (size_t j = 0; j < TransitBase<NUM_PRESETS>::preset[i].size(); j++) {
-					json_t* vJ = json_real(TransitBase<NUM_PRESETS>::preset[i][j]);
-					json_array_append_new(slotJ, vJ);
-				}
-				json_object_set(presetJ, "slot", slotJ);
+				// Values are stored as packed float32 instead of one JSON node per parameter
+				std::vector<float>& p = TransitBase<NUM_PRESETS>::preset[i];
+				std::string slotData = string::toBase64((const uint8_t*)p.data(), p.size() * sizeof(float));
+				json_object_set_new(presetJ, "slotData", json_string(slotData.c_str()));
 			}
 			json_array_append_new(presetsJ, presetJ);
 		}
@@ -92,12 +90,37 @@ struct TransitBase : Module, StripIdFixModule {
 			if (textLabelJ) textLabel[presetIndex] = json_string_value(textLabelJ);
 			preset[presetIndex].clear();
 			if (presetSlotUsed[presetIndex]) {
-				json_t* slotJ = json_object_get(presetJ, "slot");
-				json_t* vJ;
-				size_t j;
-				json_array_foreach(slotJ, j, vJ) {
-					float v = json_real_value(vJ);
-					preset[presetIndex].push_back(v);
+				json_t* slotDataJ = json_object_get(presetJ, "slotData");
+				if (slotDataJ) {
+					std::vector<uint8_t> data;
+					bool valid = json_is_string(slotDataJ);
+					if (valid) {
+						try {
+							data = string::fromBase64(json_string_value(slotDataJ));
+						}
+						catch (std::exception& e) {
+							valid = false;
+						}
+					}
+					if (valid) {
+						preset[presetIndex].resize(data.size() / sizeof(float));
+						std::memcpy(preset[presetIndex].data(), data.data(), preset[presetIndex].size() * sizeof(float));
+					}
+					else {
+						// Corrupt slot data leaves an empty slot instead of aborting the patch load
+						WARN("Invalid slot data in snapshot #%i", (int)presetIndex + 1);
+						presetSlotUsed[presetIndex] = false;
+					}
+				}
+				else {
+					// Legacy format: one JSON real per parameter
+					json_t* slotJ = json_object_get(presetJ, "slot");
+					json_t* vJ;
+					size_t j;
+					json_array_foreach(slotJ, j, vJ) {
+						float v = json_real_value(vJ);
+						preset[presetIndex].push_back(v);
+					}
 				}
 			}
 		}
@@ -5,10 +5,17 @@
 namespace StoermelderPackOne {
 namespace X4 {
 
-struct X4Module : CVMapModuleBase<2> {
+/**
+ * Fans out CHAINS source parameters to TARGETS trimpots each, changes on any
+ * trimpot are fed back to the source. TARGETS must be a multiple of 4.
+ */
+template < int CHAINS, int TARGETS >
+struct X4Module : CVMapModuleBase<CHAINS> {
+	static_assert(TARGETS % 4 == 0, "TARGETS must be a multiple of 4");
+	typedef X4Module<CHAINS, TARGETS> MODULE;
+
 	enum ParamIds {
-		ENUMS(PARAM_MAP_A, 5),
-		ENUMS(PARAM_MAP_B, 5),
+		ENUMS(PARAM_MAP, CHAINS * (TARGETS + 1)),
 		NUM_PARAMS
 	};
 	enum InputIds {
@@ -18,12 +25,9 @@ struct X4Module : CVMapModuleBase<2> {
 		NUM_OUTPUTS
 	};
 	enum LightIds {
-		ENUMS(LIGHT_MAP_A, 2),
-		ENUMS(LIGHT_MAP_B, 2),
-		ENUMS(LIGHT_RX_A, 5),
-		ENUMS(LIGHT_TX_A, 5),
-		ENUMS(LIGHT_RX_B, 5),
-		ENUMS(LIGHT_TX_B, 5),
+		ENUMS(LIGHT_MAP, CHAINS * 2),
+		ENUMS(LIGHT_RX, CHAINS * (TARGETS + 1)),
+		ENUMS(LIGHT_TX, CHAINS * (TARGETS + 1)),
 		NUM_LIGHTS
 	};
 
@@ -32,43 +36,40 @@ struct X4Module : CVMapModuleBase<2> {
 	/** [Stored to Json] */
 	bool audioRate;
 
-	/** [Stored to Json] */
-	bool readParamA[5];
-	/** [Stored to Json] */
-	bool readParamB[5];
+	/** [Stored to Json] Index 0 is the source and unused */
+	bool readParam[CHAINS][TARGETS + 1];
+
+	/** Last value of the source parameter, -1 if unknown */
+	float lastSource[CHAINS];
+	/** Last known value of each target */
+	simd::float_4 lastTarget[CHAINS][TARGETS / 4];
+	/** Mask of the targets which are read back to the source */
+	simd::float_4 readMask[CHAINS][TARGETS / 4];
 
-	float lastA[5];
-	float lastB[5];
-	int lightArx[5];
-	int lightBrx[5];
-	int lightAtx[5];
-	int lightBtx[5];
+	float lightSourceRx[CHAINS];
+	float lightSourceTx[CHAINS];
+	simd::float_4 lightRx[CHAINS][TARGETS / 4];
+	simd::float_4 lightTx[CHAINS][TARGETS / 4];
 
 	dsp::ClockDivider processDivider;
 	dsp::ClockDivider lightDivider;
 
 	X4Module() {
 		panelTheme = pluginSettings.panelThemeDefault;
-		config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS, NUM_LIGHTS);
-		configParam<MapParamQuantity<X4Module>>(PARAM_MAP_A, 0.f, 1.f, 0.f, "Map A");
-		MapParamQuantity<X4Module>* pq1 = dynamic_cast<MapParamQuantity<X4Module>*>(paramQuantities[PARAM_MAP_A]);
-		pq1->module = this;
-		pq1->id = 0;
-		configParam(PARAM_MAP_A + 1, 0.f, 1.f, 0.f, "Param A-1");
-		configParam(PARAM_MAP_A + 2, 0.f, 1.f, 0.f, "Param A-2");
-		configParam(PARAM_MAP_A + 3, 0.f, 1.f, 0.f, "Param A-3");
-		configParam(PARAM_MAP_A + 4, 0.f, 1.f, 0.f, "Param A-4");
-		configParam<MapParamQuantity<X4Module>>(PARAM_MAP_B, 0.f, 1.f, 0.f, "Map B");
-		MapParamQuantity<X4Module>* pq2 = dynamic_cast<MapParamQuantity<X4Module>*>(paramQuantities[PARAM_MAP_B]);
-		pq2->module = this;
-		pq2->id = 1;
-		configParam(PARAM_MAP_B + 1, 0.f, 1.f, 0.f, "Param B-1");
-		configParam(PARAM_MAP_B + 2, 0.f, 1.f, 0.f, "Param B-2");
-		configParam(PARAM_MAP_B + 3, 0.f, 1.f, 0.f, "Param B-3");
-		configParam(PARAM_MAP_B + 4, 0.f, 1.f, 0.f, "Param B-4");
-
-		this->paramHandles[0].text = "X4";
-		this->paramHandles[1].text = "X4";
+		Module::config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS, NUM_LIGHTS);
+		for (int c = 0; c < CHAINS; c++) {
+			int p = PARAM_MAP + c * (TARGETS + 1);
+			char name = 'A' + c;
+			Module::configParam<MapParamQuantity<MODULE>>(p, 0.f, 1.f, 0.f, string::f("Map %c", name));
+			MapParamQuantity<MODULE>* pq = dynamic_cast<MapParamQuantity<MODULE>*>(this->paramQuantities[p]);
+			pq->module = this;
+			pq->id = c;
+			for (int k = 1; k <= TARGETS; k++) {
+				Module::configParam(p + k, 0.f, 1.f, 0.f, string::f("Param %c-%i", name, k));
+			}
+			this->paramHandles[c].text = string::f("X%i", TARGETS);
+		}
+
 		processDivider.setDivision(32);
 		lightDivider.setDivision(1024);
 		onReset();
@@ -76,202 +77,175 @@ struct X4Module : CVMapModuleBase<2> {
 
 	void onReset() override {
 		audioRate = false;
-		for (size_t i = 0; i < 5; i++) {
-			readParamA[i] = readParamB[i] = true;
+		for (int c = 0; c < CHAINS; c++) {
+			for (int k = 0; k <= TARGETS; k++) {
+				readParam[c][k] = true;
+			}
+			lastSource[c] = -1.f;
+			lightSourceRx[c] = lightSourceTx[c] = 0.f;
+			for (int k = 0; k < TARGETS / 4; k++) {
+				lastTarget[c][k] = -1.f;
+				lightRx[c][k] = lightTx[c][k] = 0.f;
+			}
 		}
-		CVMapModuleBase<2>::onReset();
+		updateReadMask();
+		CVMapModuleBase<CHAINS>::onReset();
 	}
 
-	void process(const ProcessArgs& args) override {
+	void process(const Module::ProcessArgs& args) override {
 		if (audioRate || processDivider.process()) {
-			ParamQuantity* pqA = getParamQuantity(0);
-			if (pqA) {
-				float v = pqA->getScaledValue();
-				if (!isNear(v, lastA[0])) {
-					lightArx[0]++;
-					lastA[0] = v;
-					params[PARAM_MAP_A + 1].setValue(v);
-					lightAtx[1] += lastA[1] != v;
-					lastA[1] = v;
-					params[PARAM_MAP_A + 2].setValue(v);
-					lightAtx[2] += lastA[2] != v;
-					lastA[2] = v;
-					params[PARAM_MAP_A + 3].setValue(v);
-					lightAtx[3] += lastA[3] != v;
-					lastA[3] = v;
-					params[PARAM_MAP_A + 4].setValue(v);
-					lightAtx[4] += lastA[4] != v;
-					lastA[4] = v;
-				}
-				else {
-					float v1 = -1.f;
-					if (readParamA[1]) {
-						v1 = lastA[1] = params[PARAM_MAP_A + 1].getValue();
-						lightArx[1] += !isNear(v1, v);
-					}
-					if (readParamA[2] && (isNear(v, v1) || v1 == -1.f)) {
-						v1 = lastA[2] = params[PARAM_MAP_A + 2].getValue();
-						lightArx[2] += !isNear(v1, v);
-					}
-					if (readParamA[3] && (isNear(v, v1) || v1 == -1.f)) {
-						v1 = lastA[3] = params[PARAM_MAP_A + 3].getValue();
-						lightArx[3] += !isNear(v1, v);
-					}
-					if (readParamA[4] && (isNear(v, v1) || v1 == -1.f)) {
-						v1 = lastA[4] = params[PARAM_MAP_A + 4].getValue();
-						lightArx[4] += !isNear(v1, v);
-					}
-					if (!isNear(v1, lastA[0]) && v1 != -1.f) {
-						lightAtx[0]++;
-						pqA->setScaledValue(v1);
-						params[PARAM_MAP_A + 1].setValue(v1);
-						lightAtx[1] += lastA[1] != v1;
-						lastA[1] = v1;
-						params[PARAM_MAP_A + 2].setValue(v1);
-						lightAtx[2] += lastA[2] != v1;
-						lastA[2] = v1;
-						params[PARAM_MAP_A + 3].setValue(v1);
-						lightAtx[3] += lastA[3] != v1;
-						lastA[3] = v1;
-						params[PARAM_MAP_A + 4].setValue(v1);
-						lightAtx[4] += lastA[4] != v1;
-						lastA[4] = v1;
-					}
-					lastA[0] = v1;
-				}
+			for (int c = 0; c < CHAINS; c++) {
+				ParamQuantity* pq = this->getParamQuantity(c);
+				if (pq) processChain(c, pq);
 			}
+		}
 
-			ParamQuantity* pqB = getParamQuantity(1);
-			if (pqB) {
-				float v = pqB->getScaledValue();
-				if (!isNear(v, lastB[0])) {
-					lightBrx[0]++;
-					lastB[0] = v;
-					params[PARAM_MAP_B + 1].setValue(v);
-					lightBtx[1] += lastB[1] != v;
-					lastB[1] = v;
-					params[PARAM_MAP_B + 2].setValue(v);
-					lightBtx[2] += lastB[2] != v;
-					lastB[2] = v;
-					params[PARAM_MAP_B + 3].setValue(v);
-					lightBtx[3] += lastB[3] != v;
-					lastB[3] = v;
-					params[PARAM_MAP_B + 4].setValue(v);
-					lightBtx[4] += lastB[4] != v;
-					lastB[4] = v;
+		if (lightDivider.process()) {
+			float d = float(lightDivider.division) / float(audioRate ? 1 : processDivider.division);
+			for (int c = 0; c < CHAINS; c++) {
+				this->lights[LIGHT_MAP + c * 2 + 0].setBrightness(this->paramHandles[c].moduleId >= 0 && this->learningId != c ? 1.f : 0.f);
+				this->lights[LIGHT_MAP + c * 2 + 1].setBrightness(this->learningId == c ? 1.f : 0.f);
+
+				int l = c * (TARGETS + 1);
+				this->lights[LIGHT_RX + l].setBrightness(lightSourceRx[c] / d);
+				this->lights[LIGHT_TX + l].setBrightness(lightSourceTx[c] / d);
+				lightSourceRx[c] = lightSourceTx[c] = 0.f;
+				for (int k = 0; k < TARGETS; k++) {
+					this->lights[LIGHT_RX + l + k + 1].setBrightness(lightRx[c][k / 4][k % 4] / d);
+					this->lights[LIGHT_TX + l + k + 1].setBrightness(lightTx[c][k / 4][k % 4] / d);
 				}
-				else {
-					float v1 = -1.f;
-					if (readParamB[1]) {
-						v1 = lastB[1] = params[PARAM_MAP_B + 1].getValue();
-						lightBrx[1] += !isNear(v1, v);
-					}
-					if (readParamB[2] && (isNear(v, v1) || v1 == -1.f)) { 
-						v1 = lastB[2] = params[PARAM_MAP_B + 2].getValue();
-						lightBrx[2] += !isNear(v1, v);
-					}
-					if (readParamB[3] && (isNear(v, v1) || v1 == -1.f)) { 
-						v1 = lastB[3] = params[PARAM_MAP_B + 3].getValue();
-						lightBrx[3] += !isNear(v1, v);
-					}
-					if (readParamB[4] && (isNear(v, v1) || v1 == -1.f)) {
-						v1 = lastB[4] = params[PARAM_MAP_B + 4].getValue();
-						lightBrx[4] += !isNear(v1, v);
-					}
-					if (v1 != lastB[0] && v1 != -1.f) {
-						lightBtx[0]++;
-						pqB->setScaledValue(v1);
-						params[PARAM_MAP_B + 1].setValue(v1);
-						lightBtx[1] += lastB[1] != v1;
-						lastB[1] = v1;
-						params[PARAM_MAP_B + 2].setValue(v1);
-						lightBtx[2] += lastB[2] != v1;
-						lastB[2] = v1;
-						params[PARAM_MAP_B + 3].setValue(v1);
-						lightBtx[3] += lastB[3] != v1;
-						lastB[3] = v1;
-						params[PARAM_MAP_B + 4].setValue(v1);
-						lightBtx[4] += lastB[4] != v1;
-						lastB[4] = v1;
-					}
-					lastB[0] = v1;
+				for (int k = 0; k < TARGETS / 4; k++) {
+					lightRx[c][k] = lightTx[c][k] = 0.f;
 				}
 			}
 		}
 
-		if (lightDivider.process()) {
-			lights[LIGHT_MAP_A + 0].setBrightness(paramHandles[0].moduleId >= 0 && learningId != 0 ? 1.f : 0.f);
-			lights[LIGHT_MAP_A + 1].setBrightness(learningId == 0 ? 1.f : 0.f);
-			lights[LIGHT_MAP_B + 0].setBrightness(paramHandles[1].moduleId >= 0 && learningId != 1 ? 1.f : 0.f);
-			lights[LIGHT_MAP_B + 1].setBrightness(learningId == 1 ? 1.f : 0.f);
+		CVMapModuleBase<CHAINS>::process(args);
+	}
 
-			float d = float(lightDivider.division) / float(audioRate ? 1 : processDivider.division);
-			for (size_t i = 0; i < 5; i++) {
-				lights[LIGHT_RX_A + i].setBrightness(float(lightArx[i]) / d);
-				lights[LIGHT_TX_A + i].setBrightness(float(lightAtx[i]) / d);
-				lights[LIGHT_RX_B + i].setBrightness(float(lightBrx[i]) / d);
-				lights[LIGHT_TX_B + i].setBrightness(float(lightBtx[i]) / d);
-				lightArx[i] = lightBrx[i] = 0;
-				lightAtx[i] = lightBtx[i] = 0;
+	inline void processChain(int c, ParamQuantity* pq) {
+		float v = pq->getScaledValue();
+		if (!isNear(v, lastSource[c])) {
+			// Source has changed, fan out to all targets
+			lightSourceRx[c]++;
+			lastSource[c] = v;
+			setTargets(c, v);
+			return;
+		}
+
+		// Source is unchanged, look for the first readable target which has been moved
+		int p = PARAM_MAP + c * (TARGETS + 1) + 1;
+		float v1 = -1.f;
+		for (int k = 0; k < TARGETS / 4; k++) {
+			simd::float_4 t = simd::float_4(
+				this->params[p + k * 4 + 0].getValue(),
+				this->params[p + k * 4 + 1].getValue(),
+				this->params[p + k * 4 + 2].getValue(),
+				this->params[p + k * 4 + 3].getValue());
+			lastTarget[c][k] = simd::ifelse(readMask[c][k], t, lastTarget[c][k]);
+			simd::float_4 moved = readMask[c][k] & (simd::fabs(t - v) > 1e-6f);
+			int m = simd::movemask(moved);
+			if (m != 0) {
+				int j = 0;
+				while (!(m & (1 << j))) j++;
+				lightRx[c][k][j]++;
+				v1 = t[j];
+				break;
+			}
+		}
+
+		if (v1 != -1.f && !isNear(v1, lastSource[c])) {
+			lightSourceTx[c]++;
+			pq->setScaledValue(v1);
+			setTargets(c, v1);
+			lastSource[c] = v1;
+		}
+	}
+
+	inline void setTargets(int c, float v) {
+		int p = PARAM_MAP + c * (TARGETS + 1) + 1;
+		for (int k = 0; k < TARGETS; k++) {
+			this->params[p + k].setValue(v);
+		}
+		for (int k = 0; k < TARGETS / 4; k++) {
+			lightTx[c][k] += simd::ifelse(lastTarget[c][k] != v, 1.f, 0.f);
+			lastTarget[c][k] = v;
+		}
+	}
+
+	void updateReadMask() {
+		for (int c = 0; c < CHAINS; c++) {
+			for (int k = 0; k < TARGETS / 4; k++) {
+				bool* r = &readParam[c][k * 4 + 1];
+				readMask[c][k] = simd::float_4(r[0], r[1], r[2], r[3]) == 1.f;
 			}
 		}
+	}
 
-		CVMapModuleBase<2>::process(args);
+	void setReadParam(int c, int k, bool read) {
+		readParam[c][k] = read;
+		updateReadMask();
 	}
 
 	void commitLearn() override {
-		CVMapModuleBase<2>::commitLearn();
-		disableLearn(learningId);
+		CVMapModuleBase<CHAINS>::commitLearn();
+		this->disableLearn(this->learningId);
 	}
 
 	json_t* dataToJson() override {
-		json_t* rootJ = CVMapModuleBase<2>::dataToJson();
+		json_t* rootJ = CVMapModuleBase<CHAINS>::dataToJson();
 		json_object_set_new(rootJ, "panelTheme", json_integer(panelTheme));
 		json_object_set_new(rootJ, "audioRate", json_boolean(audioRate));
 
 		json_t* readParamJ = json_array();
-		json_t* readParamAJ = json_array();
-		json_t* readParamBJ = json_array();
-		for (size_t i = 0; i < 5; i++) {
-			json_array_append_new(readParamAJ, json_boolean(readParamA[i]));
-			json_array_append_new(readParamBJ, json_boolean(readParamB[i]));
+		for (int c = 0; c < CHAINS; c++) {
+			json_t* readParamCJ = json_array();
+			for (int k = 0; k <= TARGETS; k++) {
+				json_array_append_new(readParamCJ, json_boolean(readParam[c][k]));
+			}
+			json_array_append_new(readParamJ, readParamCJ);
 		}
-		json_array_append_new(readParamJ, readParamAJ);
-		json_array_append_new(readParamJ, readParamBJ);
 		json_object_set_new(rootJ, "readParam", readParamJ);
 
 		return rootJ;
 	}
 
 	void dataFromJson(json_t* rootJ) override {
-		CVMapModuleBase<2>::dataFromJson(rootJ);
+		CVMapModuleBase<CHAINS>::dataFromJson(rootJ);
 		panelTheme = json_integer_value(json_object_get(rootJ, "panelTheme"));
 		audioRate = json_boolean_value(json_object_get(rootJ, "audioRate"));
 
 		json_t* readParamJ = json_object_get(rootJ, "readParam");
 		if (!readParamJ) return;
-		json_t* readParamAJ = json_array_get(readParamJ, 0);
-		json_t* readParamBJ = json_array_get(readParamJ, 1);
-		for (size_t i = 0; i < 5; i++) {
-			readParamA[i] = json_boolean_value(json_array_get(readParamAJ, i));
-			readParamB[i] = json_boolean_value(json_array_get(readParamBJ, i));
+		for (int c = 0; c < CHAINS; c++) {
+			json_t* readParamCJ = json_array_get(readParamJ, c);
+			for (int k = 0; k <= TARGETS; k++) {
+				readParam[c][k] = json_boolean_value(json_array_get(readParamCJ, k));
+			}
 		}
+		updateReadMask();
 	}
 };
 
-
-
+template < typename MODULE >
 struct X4Trimpot : StoermelderTrimpot {
-	bool* readParam;
+	MODULE* module;
+	int chain;
+	int target;
+
+	void toggleReadParam() {
+		module->setReadParam(chain, target, !module->readParam[chain][target]);
+	}
 
 	void onDoubleClick(const event::DoubleClick& e) override {
-		*readParam ^= true;
+		if (!module) return;
+		toggleReadParam();
 	}
 
 	void onButton(const event::Button& e) override {
 		StoermelderTrimpot::onButton(e);
 		// Right click to open context menu
-		if (e.action == GLFW_PRESS && e.button == GLFW_MOUSE_BUTTON_RIGHT && (e.mods & RACK_MOD_MASK) == 0) {
+		if (module && e.action == GLFW_PRESS && e.button == GLFW_MOUSE_BUTTON_RIGHT && (e.mods & RACK_MOD_MASK) == 0) {
 			extendContextMenu();
 		}
 	}
@@ -285,12 +259,12 @@ struct X4Trimpot : StoermelderTrimpot {
 		if (!menu) return;
 
 		struct ReadItem : MenuItem {
-			X4Trimpot* p;
+			X4Trimpot<MODULE>* p;
 			void onAction(const event::Action& e) override {
-				*p->readParam ^= true;
+				p->toggleReadParam();
 			}
 			void step() override {
-				rightText = CHECKMARK(*p->readParam);
+				rightText = CHECKMARK(p->module->readParam[p->chain][p->target]);
 				MenuItem::step();
 			}
 		};
@@ -301,57 +275,61 @@ struct X4Trimpot : StoermelderTrimpot {
 };
 
 
-struct X4Widget : ThemedModuleWidget<X4Module> {
-	X4Widget(X4Module* module)
-		: ThemedModuleWidget<X4Module>(module, "X4") {
-		setModule(module);
-
-		addChild(createWidget<StoermelderBlackScrew>(Vec(0, 0)));
-		addChild(createWidget<StoermelderBlackScrew>(Vec(box.size.x - 1 * RACK_GRID_WIDTH, RACK_GRID_HEIGHT - RACK_GRID_WIDTH)));
-
-		float o = 26.7f;
-
-		MapButton<X4Module>* buttonA = createParamCentered<MapButton<X4Module>>(Vec(15.f, 59.5f), module, X4Module::PARAM_MAP_A);
-		buttonA->setModule(module);
-		buttonA->id = 0;
-		addParam(buttonA);
-		addChild(createLightCentered<TinyLight<YellowLight>>(Vec(6.1f, 47.4f), module, X4Module::LIGHT_RX_A));
-		addChild(createLightCentered<MapLight<GreenRedLight>>(Vec(15.f, 59.5f), module, X4Module::LIGHT_MAP_A));
-		addChild(createLightCentered<TinyLight<BlueLight>>(Vec(24.0f, 47.4f), module, X4Module::LIGHT_TX_A));
-
-		for (size_t i = 0; i < 4; i++) {
-			addChild(createLightCentered<TinyLight<YellowLight>>(Vec(6.1f, 80.7f + o * i), module, X4Module::LIGHT_RX_A + i + 1));
-			X4Trimpot* tp = createParamCentered<X4Trimpot>(Vec(15.f, 91.2f + o * i), module, X4Module::PARAM_MAP_A + i + 1);
-			tp->readParam = &module->readParamA[i + 1];
-			addParam(tp);
-			addChild(createLightCentered<TinyLight<BlueLight>>(Vec(24.0f, 80.7f + o * i), module, X4Module::LIGHT_TX_A + i + 1));
-		}
-
-		MapButton<X4Module>* buttonB = createParamCentered<MapButton<X4Module>>(Vec(15.f, 210.6f), module, X4Module::PARAM_MAP_B);
-		buttonB->setModule(module);
-		buttonB->id = 1;
-		addParam(buttonB);
-		addChild(createLightCentered<TinyLight<YellowLight>>(Vec(6.1f, 198.5f), module, X4Module::LIGHT_RX_B));
-		addChild(createLightCentered<MapLight<GreenRedLight>>(Vec(15.f, 210.6f), module, X4Module::LIGHT_MAP_B));
-		addChild(createLightCentered<TinyLight<BlueLight>>(Vec(24.0f, 198.5f), module, X4Module::LIGHT_TX_B));
-
-		for (size_t i = 0; i < 4; i++) {
-			addChild(createLightCentered<TinyLight<YellowLight>>(Vec(6.1f, 231.7f + o * i), module, X4Module::LIGHT_RX_B + i + 1));
-			X4Trimpot* tp = createParamCentered<X4Trimpot>(Vec(15.f, 242.2f + o * i), module, X4Module::PARAM_MAP_B + i + 1);
-			tp->readParam = &module->readParamB[i + 1];
-			addParam(tp);
-			addChild(createLightCentered<TinyLight<BlueLight>>(Vec(24.0f, 231.7f + o * i), module, X4Module::LIGHT_TX_B + i + 1));
+/**
+ * Lays out the chains of an X4Module in columns of 8 trimpots: chains with
+ * less than 8 targets share a column, larger chains span several columns.
+ */
+template < typename MODULE, int CHAINS, int TARGETS >
+struct X4WidgetBase : ThemedModuleWidget<MODULE> {
+	typedef ThemedModuleWidget<MODULE> BASE;
+	static const int ROWS = 8;
+
+	X4WidgetBase(MODULE* module, std::string baseName)
+		: BASE(module, baseName, "X4") {
+		BASE::setModule(module);
+
+		const int chainsPerColumn = std::max(1, ROWS / TARGETS);
+		const int columnsPerChain = std::max(1, TARGETS / ROWS);
+		const int rowsPerColumn = TARGETS / columnsPerChain;
+		// A single chain per column spreads its targets over the whole column
+		const float o = chainsPerColumn == 1 ? 231.1f / (rowsPerColumn - 1) : 26.7f;
+
+		for (int c = 0; c < CHAINS; c++) {
+			int p = MODULE::PARAM_MAP + c * (TARGETS + 1);
+			int l = c * (TARGETS + 1);
+			int column = (c / chainsPerColumn) * columnsPerChain;
+			float y = 151.1f * (c % chainsPerColumn);
+			float x = 15.f + 30.f * column + 15.f * (columnsPerChain - 1);
+
+			MapButton<MODULE>* button = createParamCentered<MapButton<MODULE>>(Vec(x, 59.5f + y), module, p);
+			button->setModule(module);
+			button->id = c;
+			BASE::addParam(button);
+			BASE::addChild(createLightCentered<TinyLight<YellowLight>>(Vec(x - 8.9f, 47.4f + y), module, MODULE::LIGHT_RX + l));
+			BASE::addChild(createLightCentered<MapLight<GreenRedLight>>(Vec(x, 59.5f + y), module, MODULE::LIGHT_MAP + c * 2));
+			BASE::addChild(createLightCentered<TinyLight<BlueLight>>(Vec(x + 9.0f, 47.4f + y), module, MODULE::LIGHT_TX + l));
+
+			for (int i = 0; i < TARGETS; i++) {
+				float xi = 15.f + 30.f * (column + i / rowsPerColumn);
+				float yi = y + o * (i % rowsPerColumn);
+				BASE::addChild(createLightCentered<TinyLight<YellowLight>>(Vec(xi - 8.9f, 80.7f + yi), module, MODULE::LIGHT_RX + l + i + 1));
+				X4Trimpot<MODULE>* tp = createParamCentered<X4Trimpot<MODULE>>(Vec(xi, 91.2f + yi), module, p + i + 1);
+				tp->module = module;
+				tp->chain = c;
+				tp->target = i + 1;
+				BASE::addParam(tp);
+				BASE::addChild(createLightCentered<TinyLight<BlueLight>>(Vec(xi + 9.0f, 80.7f + yi), module, MODULE::LIGHT_TX + l + i + 1));
+			}
 		}
 	}
 
-
 	void appendContextMenu(Menu* menu) override {
-		ThemedModuleWidget<X4Module>::appendContextMenu(menu);
-		X4Module* module = dynamic_cast<X4Module*>(this->module);
+		BASE::appendContextMenu(menu);
+		MODULE* module = dynamic_cast<MODULE*>(this->module);
 		assert(module);
 
 		struct AudioRateItem : MenuItem {
-			X4Module* module;
+			MODULE* module;
 			void onAction(const event::Action& e) override {
 				module->audioRate ^= true;
 			}
@@ -366,7 +344,24 @@ struct X4Widget : ThemedModuleWidget<X4Module> {
 	}
 };
 
+struct X4Widget : X4WidgetBase<X4Module<2, 4>, 2, 4> {
+	X4Widget(X4Module<2, 4>* module)
+		: X4WidgetBase<X4Module<2, 4>, 2, 4>(module, "X4") {
+		addChild(createWidget<StoermelderBlackScrew>(Vec(0, 0)));
+		addChild(createWidget<StoermelderBlackScrew>(Vec(box.size.x - 1 * RACK_GRID_WIDTH, RACK_GRID_HEIGHT - RACK_GRID_WIDTH)));
+	}
+};
+
+struct X16Widget : X4WidgetBase<X4Module<1, 16>, 1, 16> {
+	X16Widget(X4Module<1, 16>* module)
+		: X4WidgetBase<X4Module<1, 16>, 1, 16>(module, "X16") {
+		addChild(createWidget<StoermelderBlackScrew>(Vec(RACK_GRID_WIDTH, 0)));
+		addChild(createWidget<StoermelderBlackScrew>(Vec(box.size.x - 2 * RACK_GRID_WIDTH, RACK_GRID_HEIGHT - RACK_GRID_WIDTH)));
+	}
+};
+
 } // namespace X4 
 } // namespace StoermelderPackOne
 
-Model* modelX4 = createModel<StoermelderPackOne::X4::X4Module, StoermelderPackOne::X4::X4Widget>("X4");
\ No newline at end of file
+Model* modelX4 = createModel<StoermelderPackOne::X4::X4Module<2, 4>, StoermelderPackOne::X4::X4Widget>("X4");
+Model* modelX16 = createModel<StoermelderPackOne::X4::X4Module<1, 16>, StoermelderPackOne::X4::X16Widget>("X16");
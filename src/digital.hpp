@@ -146,6 +146,27 @@ struct LinearFade4 {
 };
 
 
+struct ExponentialFilter4 {
+	simd::float_4 out = 0.f;
+	simd::float_4 lambda = 0.f;
+
+	void reset() {
+		out = 0.f;
+	}
+
+	void reset(int i) {
+		out[i] = 0.f;
+	}
+
+	inline simd::float_4 process(float deltaTime, simd::float_4 in) {
+		simd::float_4 y = out + (in - out) * lambda * deltaTime;
+		// If no change was made between the old and new output snap output to input, same as dsp::ExponentialFilter
+		out = simd::ifelse(out == y, in, y);
+		return out;
+	}
+};
+
+
 struct StoermelderSlewLimiter {
 	// Minimum and maximum slopes in volts per second
 	const float slewMin = 0.1;
@@ -193,4 +214,45 @@ struct StoermelderSlewLimiter {
 		}
 		return out;
 	}
-};
\ No newline at end of file
+};
+
+/** Seedable xoroshiro128+ generator with a geometric sampler, does not allocate */
+struct CursorRandom {
+	uint64_t s[2] = { 1, 0 };
+	/** 1 / log(1 - p) for the geometric distribution with success probability p */
+	float geoScale = 0.f;
+
+	void seed(uint64_t seed) {
+		// splitmix64 spreads neighbouring seeds over the whole state
+		for (int i = 0; i < 2; i++) {
+			uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+			s[i] = z ^ (z >> 31);
+		}
+	}
+
+	inline uint64_t next() {
+		uint64_t s0 = s[0];
+		uint64_t s1 = s[1];
+		uint64_t r = s0 + s1;
+		s1 ^= s0;
+		s[0] = ((s0 << 24) | (s0 >> 40)) ^ s1 ^ (s1 << 16);
+		s[1] = (s1 << 37) | (s1 >> 27);
+		return r;
+	}
+
+	/** Returns a float within [0, 1) */
+	inline float uniform() {
+		return (next() >> 40) * (1.f / 16777216.f);
+	}
+
+	void setGeometric(float p) {
+		geoScale = 1.f / std::log1p(-clamp(p, 1e-6f, 1.f - 1e-6f));
+	}
+
+	/** Number of failures before the first success, same as std::geometric_distribution */
+	inline int geometric() {
+		return int(std::log(1.f - uniform()) * geoScale);
+	}
+};
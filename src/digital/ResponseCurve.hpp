@@ -0,0 +1,118 @@
+#pragma once
+#include "plugin.hpp"
+#include <atomic>
+
+namespace StoermelderPackOne {
+
+struct ResponseCurve {
+	enum class CURVE {
+		LINEAR = 0,
+		EXP = 1,
+		LOG = 2,
+		SCURVE = 3,
+		TABLE = 4
+	};
+
+	static const int LUT_SIZE = 256;
+	static const int BREAKPOINTS = 5;
+	/** Steepness of the exponential and logarithmic curves */
+	static constexpr float K = 4.f;
+
+	CURVE curve;
+	/** Output values of the breakpoint table at equidistant input positions */
+	float breakpoints[BREAKPOINTS];
+	/** Two tables, the GUI-thread fills the unused one and swaps the pointer when done */
+	float lutBuffer[2][LUT_SIZE + 1];
+	std::atomic<float*> lut{lutBuffer[0]};
+
+	ResponseCurve() {
+		reset();
+	}
+
+	void reset() {
+		for (int i = 0; i < BREAKPOINTS; i++) {
+			breakpoints[i] = float(i) / float(BREAKPOINTS - 1);
+		}
+		setCurve(CURVE::LINEAR);
+	}
+
+	void setCurve(CURVE curve) {
+		this->curve = curve;
+		updateLut();
+	}
+
+	CURVE getCurve() {
+		return curve;
+	}
+
+	void setBreakpoint(int i, float v) {
+		breakpoints[i] = clamp(v, 0.f, 1.f);
+		updateLut();
+	}
+
+	float getBreakpoint(int i) {
+		return breakpoints[i];
+	}
+
+	/** Evaluates the curve at x using the precomputed table, x is expected to be within [0, 1] */
+	inline float process(float x) {
+		if (curve == CURVE::LINEAR) return x;
+		float p = clamp(x, 0.f, 1.f) * LUT_SIZE;
+		int i = std::min(int(p), LUT_SIZE - 1);
+		const float* t = lut.load(std::memory_order_acquire);
+		return crossfade(t[i], t[i + 1], p - i);
+	}
+
+	json_t* toJson() {
+		json_t* curveJ = json_object();
+		json_object_set_new(curveJ, "curve", json_integer((int)curve));
+		json_t* breakpointsJ = json_array();
+		for (int i = 0; i < BREAKPOINTS; i++) {
+			json_array_append_new(breakpointsJ, json_real(breakpoints[i]));
+		}
+		json_object_set_new(curveJ, "breakpoints", breakpointsJ);
+		return curveJ;
+	}
+
+	void fromJson(json_t* curveJ) {
+		json_t* breakpointsJ = json_object_get(curveJ, "breakpoints");
+		if (breakpointsJ) {
+			json_t* breakpointJ;
+			size_t i;
+			json_array_foreach(breakpointsJ, i, breakpointJ) {
+				if (i >= BREAKPOINTS) break;
+				breakpoints[i] = clamp((float)json_real_value(breakpointJ), 0.f, 1.f);
+			}
+		}
+		setCurve((CURVE)json_integer_value(json_object_get(curveJ, "curve")));
+	}
+
+	float evaluate(float x) {
+		switch (curve) {
+			default:
+			case CURVE::LINEAR:
+				return x;
+			case CURVE::EXP:
+				return (std::exp(K * x) - 1.f) / (std::exp(K) - 1.f);
+			case CURVE::LOG:
+				return std::log(1.f + x * (std::exp(K) - 1.f)) / K;
+			case CURVE::SCURVE:
+				return 0.5f - 0.5f * std::cos(float(M_PI) * x);
+			case CURVE::TABLE: {
+				float p = x * (BREAKPOINTS - 1);
+				int i = std::min(int(p), BREAKPOINTS - 2);
+				return crossfade(breakpoints[i], breakpoints[i + 1], p - i);
+			}
+		}
+	}
+
+	void updateLut() {
+		float* t = lut.load(std::memory_order_relaxed) == lutBuffer[0] ? lutBuffer[1] : lutBuffer[0];
+		for (int i = 0; i <= LUT_SIZE; i++) {
+			t[i] = evaluate(float(i) / float(LUT_SIZE));
+		}
+		lut.store(t, std::memory_order_release);
+	}
+}; // struct ResponseCurve
+
+} // namespace StoermelderPackOne
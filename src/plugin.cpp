@@ -46,7 +46,9 @@ void init(rack::Plugin* p) {
 	p->addModel(modelTransit);
 	p->addModel(modelTransitEx);
 	p->addModel(modelX4);
+	p->addModel(modelX16);
 	p->addModel(modelMacro);
+	p->addModel(modelMacroX2);
 	p->addModel(modelRaw);
 	p->addModel(modelMidiMon);
 	p->addModel(modelOrbit);
@@ -50,7 +50,9 @@ extern Model* modelSpin;
 extern Model* modelTransit;
 extern Model* modelTransitEx;
 extern Model* modelX4;
+extern Model* modelX16;
 extern Model* modelMacro;
+extern Model* modelMacroX2;
 extern Model* modelRaw;
 extern Model* modelMidiMon;
 extern Model* modelOrbit;